@@ -15,7 +15,14 @@
 #include <Preferences.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
+#include <freertos/task.h>
 #include "config.h"
+#include "runtime_stats.h"
+#include "boot_profile.h"
+#include "epd_status.h"
+#include "epd_compositor.h"
+#include "epd_panel.h"
+#include "epd_refresh.h"
 
 // --- Enum for commands sent to the Clock/Display task ---
 enum class SystemCommandType {
@@ -23,11 +30,21 @@ enum class SystemCommandType {
     PREV_COLOR_SCHEME,
     SHOW_WIFI_ANIMATION,
     START_CLOCK_DISPLAY,
+    DUMP_FRAME,          // Debug console: print the LED frame as ASCII
+    DUMP_FRAME_PPM,      // Debug console: print the LED frame as a PPM image
+    BENCHMARK_SCHEMES,   // Debug console: time every color scheme
+    BENCHMARK_DAY,       // Debug console: render and check every minute of a day
+    PRINT_STATS,         // Debug console: print queue, frame and EPD timings
+    RESET_STATS,         // Debug console: clear the timings and profile
+    PRINT_PROFILE,       // Debug console: print the cycle-count profile
+    PRINT_BOOT_PROFILE,  // Debug console: print when each boot phase was reached
+    EPD_FULL_REFRESH,    // Debug console: full e-paper refresh, even if unchanged, to clear ghosting
 };
 
 // --- Struct for system commands ---
 struct SystemCommand {
     SystemCommandType type;
+    uint32_t sent_us = micros(); // Stamped on creation, to measure time spent in the queue
 };
 
 // --- Enum for events sent to the WiFi/Network task ---
@@ -45,7 +62,7 @@ struct AppContext {
     // Hardware Objects
     RTC_DS3231 rtc;
     CRGB leds[NUM_LEDS];
-Adafruit_SSD1680 display;
+    EpdPanel display; // Adafruit_SSD1680 with an interrupt-driven busy wait
  //Adafruit_SSD1675 display;
 //Adafruit_SSD1675B display;
     //Adafruit_UC8151D display;
@@ -54,20 +71,44 @@ Adafruit_SSD1680 display;
     Preferences preferences;
 
     // RTOS Handles
-    QueueHandle_t systemCommandQueue;
+    QueueHandle_t systemCommandQueue; // Send with sendSystemCommand(), which wakes the clock task
+    TaskHandle_t clockTask = nullptr; // Notified for each command and, with RTC_SQW_PIN, each RTC second
     QueueHandle_t networkEventQueue;
-    QueueHandle_t epdQueue;
+    QueueHandle_t epdQueue; // EpdUpdate requests for task_epd
+    EventGroupHandle_t bootEvents; // BOOT_* bits from boot_profile.h
 
     // State Variables
     char time_zone[64] = "UTC";
+    volatile uint32_t tz_generation = 0; // Bumped whenever TZ is set, so cached offsets are dropped
     int colorSchemeIndex = 0;
     bool time_is_valid = false;
     uint32_t display_offset_x = 0;
     uint32_t display_offset_y = 16;
     const uint32_t maxiumum_offset = 16;
+    EpdStatusScreen status_screen{(int16_t)display_offset_x, (int16_t)display_offset_y}; // Drawn by the WiFi task
+    EpdCompositor epd_frames; // Drawn into by the WiFi task, shown by the EPD task
+
+    // LED frame statistics, written by the clock task
+    volatile uint32_t frames_rendered = 0; // Frames drawn into the LED buffer
+    volatile uint32_t frames_pushed = 0;   // Frames actually sent to the strip
+    volatile uint32_t clock_wakeups = 0;   // Times the clock task woke up
+    volatile uint32_t rtc_edge_us = 0;     // micros() at the last RTC 1 Hz edge, if RTC_SQW_PIN is used
+
+    // Timings for measuring scheduling changes, see the console "stats" command
+    TimingStats command_latency; // Command creation to handling, clock task
+    TimingStats frame_render;    // Drawing one LED frame, clock task
+    TimingStats frame_interval;  // Between frames pushed to the strip, clock task
+    TimingStats epd_refresh;     // One e-paper update incl. power up/down, EPD task
+    TimingStats minute_latency;  // Start of a minute to its first frame on the LEDs, clock task
+    EpdRefreshState epd_refreshes;               // Refresh decisions and counts, EPD task
+    volatile uint32_t epd_active_ms = 0;         // Time the panel was powered up, EPD task
+    LatencyHistogram sync_timezone; // Timezone fetch attempts, WiFi task
+    LatencyHistogram sync_ntp;      // SNTP attempts, start to SNTP_SYNC or timeout, WiFi task
+    BootProfile boot_profile;       // Each phase written once, by the task that reaches it
+
     // Constructor to initialize aggregated objects like the display
     //AppContext() : display(212, 104, EPD_DC, EPD_RESET, EPD_CS, SRAM_CS, EPD_BUSY, EPD_SPI) {}
-    AppContext() : display(250, 122, EPD_DC, EPD_RESET, EPD_CS, SRAM_CS, EPD_BUSY, EPD_SPI) {}
+    AppContext() : display(250, 122, EPD_DC, EPD_RESET, EPD_CS, SRAM_CS, EPD_BUSY, EPD_SPI), epd_frames(250, 122) {}
 };
 
 #endif // APP_CONTEXT_H
@@ -0,0 +1,36 @@
+/**
+ * @file animation_engine.cpp
+ * @brief Implementation of the animation stack.
+ */
+
+#include "animation_engine.h"
+
+void AnimationStack::push(const Animation& anim) {
+    if (depth == MAX_DEPTH) {
+        // Drop the oldest animation to make room
+        for (uint8_t i = 1; i < MAX_DEPTH; i++) {
+            stack[i - 1] = stack[i];
+        }
+        depth--;
+    }
+    stack[depth++] = anim;
+}
+
+void AnimationStack::start(const Animation& anim) {
+    if (depth > 0 && stack[depth - 1].kind == anim.kind) {
+        stack[depth - 1] = anim;
+    } else {
+        push(anim);
+    }
+}
+
+bool AnimationStack::tick(CRGB* leds, uint32_t now) {
+    if (depth == 0) {
+        return false;
+    }
+    Animation& top = stack[depth - 1];
+    if (!top.tick(top, leds, now)) {
+        depth--;
+    }
+    return true;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file animation_engine.h
+ * @brief Frame-driven engine for full-display animations.
+ *
+ * An animation is a small state object with a tick() step function. The clock
+ * task ticks the active animation once per frame instead of the animation
+ * blocking the task with delay loops, so commands keep being handled while
+ * an animation plays.
+ */
+#ifndef ANIMATION_ENGINE_H
+#define ANIMATION_ENGINE_H
+
+#include <FastLED.h>
+
+struct Animation;
+
+// Advances an animation to time `now` (in ms) and draws it into the LED array.
+// Returns false once the animation has finished.
+typedef bool (*AnimationTick)(Animation& anim, CRGB* leds, uint32_t now);
+
+// Identifies an animation so a newer one of the same kind can replace it.
+enum class AnimationKind : uint8_t {
+    INDICATE_NUMBER,
+    WIFI_CONNECT,
+    HOLD,
+};
+
+struct Animation {
+    AnimationTick tick;
+    AnimationKind kind;
+    uint32_t startTime; // millis() when the animation started
+    uint32_t lastTick;  // Time the last fade step was applied, for frame-rate independent fades
+    uint32_t duration;  // Total length in ms, where the animation needs it
+    CHSV color;
+    uint8_t number;
+};
+
+/**
+ * @brief A small stack of active animations.
+ *
+ * Only the top animation is ticked. When it finishes it is popped and the one
+ * below continues on its own timeline.
+ */
+class AnimationStack {
+public:
+    static constexpr uint8_t MAX_DEPTH = 4;
+
+    /**
+     * @brief Starts an animation on top of the stack, dropping the oldest if full.
+     * @param anim The animation to start.
+     */
+    void push(const Animation& anim);
+
+    /**
+     * @brief Starts an animation, interrupting the top one if it is of the same kind.
+     * @param anim The animation to start.
+     */
+    void start(const Animation& anim);
+
+    /**
+     * @brief Stops all animations.
+     */
+    void clear() { depth = 0; }
+
+    /**
+     * @brief Returns true while any animation is running.
+     */
+    bool active() const { return depth > 0; }
+
+    /**
+     * @brief Ticks the top animation and pops it once it has finished.
+     * @param leds Pointer to the CRGB LED array.
+     * @param now Current time in ms.
+     * @return true if an animation drew this frame.
+     */
+    bool tick(CRGB* leds, uint32_t now);
+
+private:
+    Animation stack[MAX_DEPTH];
+    uint8_t depth = 0;
+};
+
+#endif // ANIMATION_ENGINE_H
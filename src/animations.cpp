@@ -2,8 +2,8 @@
  * @file animations.cpp
  * @brief Implementation of LED animations for the Word Clock.
  *
- * All blocking delay() calls have been replaced with vTaskDelay() to make
- * them suitable for a FreeRTOS environment.
+ * Full-display animations are step functions ticked once per frame by the
+ * clock task, so none of them block it.
  */
 
 #include "animations.h"
@@ -11,203 +11,140 @@
 #include "config.h"
 #include "word_layout.h"
 
-// --- Helper for rainbowSentences ---
-static bool firstWord = true;
-extern const Word* W_IT;
-// --- Full-Display Animations (RTOS-Friendly) ---
+// --- Full-Display Animations (Frame-Driven) ---
 
-void indicateNumber(CRGB *leds, uint8_t num, CHSV color)
+// Applies a fade of `amount` for every 10ms elapsed since the last fade step,
+// so the fade speed does not depend on the frame rate.
+static void fadeSince(Animation &anim, CRGB *leds, uint8_t amount, uint32_t now)
 {
-    // Fade out over ~500ms
-    for (int i = 0; i < 50; i++)
+    uint32_t steps = (now - anim.lastTick) / 10;
+    if (steps > 50)
+        steps = 50; // Fully faded long before this
+    for (uint32_t i = 0; i < steps; i++)
     {
-        fadeToBlackBy(leds, NUM_LEDS, 16);
-        FastLED.show();
-        vTaskDelay(pdMS_TO_TICKS(10));
+        fadeToBlackBy(leds, NUM_LEDS, amount);
     }
+    anim.lastTick += steps * 10;
+}
 
-    FastLED.clear();
+static bool tickIndicateNumber(Animation &anim, CRGB *leds, uint32_t now)
+{
+    uint32_t elapsed = now - anim.startTime;
 
-    // Select and display the word for the given number
-    const Word *word_to_show = nullptr;
-    switch (num)
+    if (elapsed < 500)
     {
-    case 1:
-        word_to_show = W_ONE;
-        break;
-    case 2:
-        word_to_show = W_TWO;
-        break;
-    case 3:
-        word_to_show = W_THREE;
-        break;
-    case 4:
-        word_to_show = W_FOUR;
-        break;
-    case 5:
-        word_to_show = W_FIVE;
-        break;
-        // Cases 6 through 12 can be added if needed
+        // Fade out the current display
+        fadeSince(anim, leds, 16, now);
+        return true;
     }
 
-    if (word_to_show)
+    if (elapsed < 1000)
     {
-        // Use a simple, solid color for the indicator
-        for (int i = 0; i < word_to_show->wordLength; i++)
+        // Show the word for the given number
+        fill_solid(leds, NUM_LEDS, CRGB::Black);
+        if (anim.number >= 1 && anim.number <= 12)
         {
-            leds[word_to_show->startIndex + i] = color;
+            // Use a simple, solid color for the indicator
+            CHSV color = anim.color;
+            forEachLed(wordMask(static_cast<WordId>(WORD_ONE + anim.number - 1)), [&](uint8_t i)
+            {
+                leds[i] = color;
+            });
         }
+        anim.lastTick = now;
+        return true;
     }
-    FastLED.show();
-
-    // Hold for 500ms
-    vTaskDelay(pdMS_TO_TICKS(500));
 
-    // Fade out again
-    for (int i = 0; i < 50; i++)
+    if (elapsed < 1500)
     {
-        fadeToBlackBy(leds, NUM_LEDS, 16);
-        FastLED.show();
-        vTaskDelay(pdMS_TO_TICKS(10));
+        // Fade out again
+        fadeSince(anim, leds, 16, now);
+        return true;
     }
-    FastLED.clear();
-    FastLED.show();
+
+    fill_solid(leds, NUM_LEDS, CRGB::Black);
+    return false;
 }
 
-void wifiConnectAnimation(CRGB *leds)
+static bool tickWifiConnect(Animation &anim, CRGB *leds, uint32_t now)
 {
-    uint8_t hue = 0;
+    uint32_t elapsed = now - anim.startTime;
 
-    // Fade out existing display
-    for (int i = 0; i < 100; i++)
+    if (elapsed < 1000)
     {
-        fadeToBlackBy(leds, NUM_LEDS, 8);
-        FastLED.show();
-        vTaskDelay(pdMS_TO_TICKS(10));
+        // Fade out existing display
+        fadeSince(anim, leds, 8, now);
+        return true;
     }
 
-    // Rainbow animation for 6 seconds
-    for (int i = 0; i < 600; i++)
+    if (elapsed < 7000)
     {
-        writeAllWords(leds, CHSV(hue++, 255, 255), 10);
-        FastLED.show();
-        vTaskDelay(pdMS_TO_TICKS(10));
+        // Rainbow animation for 6 seconds, one hue step every 10ms
+        uint8_t hue = (elapsed - 1000) / 10;
+        writeAllWords(leds, CHSV(hue, 255, 255), 10);
+        anim.lastTick = now;
+        return true;
     }
 
-    // Fade to black
-    for (int i = 0; i < 100; i++)
+    if (elapsed < 8000)
     {
-        fadeToBlackBy(leds, NUM_LEDS, 8);
-        FastLED.show();
-        vTaskDelay(pdMS_TO_TICKS(10));
+        // Fade to black
+        fadeSince(anim, leds, 8, now);
+        return true;
     }
-    FastLED.clear();
-    FastLED.show();
-}
 
-// Helper to light up all words for animations
-
-void writeAllWords(CRGB *ledArray, CHSV color, int rate)
-{
-    for (int i = 0; i < numWords; i++)
-    {
-        rainbowRipple(clockWords[i], ledArray, color);
-    }
-    // vTaskDelay(pdMS_TO_TICKS(rate));
+    fill_solid(leds, NUM_LEDS, CRGB::Black);
+    return false;
 }
 
-// --- Per-Word Color Scheme Implementations ---
-
-void rainbowRipple(const Word &w, CRGB *ledArray, CHSV color)
+static bool tickHold(Animation &anim, CRGB *, uint32_t now)
 {
-    uint8_t base = color.hue;
-    for (int i = 0; i < w.wordLength; i++)
-    {
-        float letterX = w.x + i;
-        float letterY = (float)w.y * 1.6;
-        float distance = sqrt(pow(letterX, 2) + pow(letterY, 2));
-        long dist = (long)(distance * 8);
-        dist = dist % 256;
-        color.hue = base - (uint8_t)dist;
-        ledArray[w.startIndex + i] = color;
-    }
+    // Leaves the current frame untouched until the hold time has passed
+    return now - anim.startTime < anim.duration;
 }
 
-void randomizedWordColors(const Word &w, CRGB *ledArray, CHSV color)
+Animation indicateNumberAnimation(uint8_t num, CHSV color, uint32_t now)
 {
-    static uint8_t wordHues[23];
-    static bool initialized = false;
-    if (!initialized)
-    {
-        for (int i = 0; i < numWords; i++)
-            wordHues[i] = random8();
-        initialized = true;
-    }
-
-    EVERY_N_SECONDS(1)
-    {
-        for (int k = 0; k < numWords; k++)
-        {
-            wordHues[k] = random8();
-        }
-    }
-
-    uint8_t thisWordHue = 0;
-    for (int k = 0; k < numWords; k++)
-    {
-        if (clockWords[k].startIndex == w.startIndex)
-        {
-            thisWordHue = wordHues[k];
-            break;
-        }
-    }
-    for (int i = 0; i < w.wordLength; i++)
-    {
-        ledArray[w.startIndex + i] = CHSV(thisWordHue, 255, 255);
-    }
+    Animation anim = {};
+    anim.tick = tickIndicateNumber;
+    anim.kind = AnimationKind::INDICATE_NUMBER;
+    anim.startTime = now;
+    anim.lastTick = now;
+    anim.color = color;
+    anim.number = num;
+    return anim;
 }
 
-void rainbowSentences(const Word &w, CRGB *ledArray, CHSV color)
+Animation wifiConnectAnimation(uint32_t now)
 {
-    
-    static uint8_t hueIndex = 0;
-    if (w.word.compareTo("it"))
-    {
-        hueIndex = color.hue;
-        
-    }
-    for (int i = 0; i < w.wordLength; i++)
-    {
-        ledArray[w.startIndex + i] = CHSV(hueIndex, 255, 255);
-        hueIndex -= 8;
-    }
+    Animation anim = {};
+    anim.tick = tickWifiConnect;
+    anim.kind = AnimationKind::WIFI_CONNECT;
+    anim.startTime = now;
+    anim.lastTick = now;
+    return anim;
 }
 
-void timeColorChange(const Word &w, CRGB *ledArray, CHSV color)
+Animation holdAnimation(uint32_t duration, uint32_t now)
 {
-    // This animation changes color over 24 hours. The hue is based on the time.
-    time_t now;
-    struct tm timeinfo;
-    time(&now);                   // Get current system time (epoch)
-    localtime_r(&now, &timeinfo); // Convert to local time structure
-
-    unsigned int dayMinutes = (timeinfo.tm_hour * 60) + timeinfo.tm_min;
-    CHSV timeColor = CHSV((map(dayMinutes, 0, 780, 0, 255) + 10 * w.startIndex), 255, 255);
-    for (int i = 0; i < w.wordLength; i++)
-    {
-        ledArray[w.startIndex + i] = timeColor;
-    }
+    Animation anim = {};
+    anim.tick = tickHold;
+    anim.kind = AnimationKind::HOLD;
+    anim.startTime = now;
+    anim.lastTick = now;
+    anim.duration = duration;
+    return anim;
 }
 
-void noiseFieldWords(const Word &w, CRGB *ledArray, CHSV color)
+// Helper to light up all words for animations
+
+void writeAllWords(CRGB *ledArray, CHSV color, int rate)
 {
-    uint16_t scale = 2000;
-    for (int i = 0; i < w.wordLength; i++)
+    LedMask allWords = 0;
+    for (const Word &w : clockWords)
     {
-        uint32_t real_x = (10 * w.x + (10 * i)) * scale;
-        uint32_t real_y = 10 * w.y * scale;
-        uint32_t real_z = millis() * 20;
-        uint8_t noise = inoise16(real_x, real_y, real_z) >> 8;
-        ledArray[w.startIndex + i] = CHSV(noise, 255, 255);
+        allWords |= wordMask(w);
     }
+    rainbowRipple(allWords, ledArray, color);
+    // vTaskDelay(pdMS_TO_TICKS(rate));
 }
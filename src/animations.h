@@ -8,29 +8,15 @@
 #include <FastLED.h>
 #include "word_layout.h"
 #include "config.h"
-
-// Enum to define the different color schemes available.
-enum ColorScheme {
-    RAINBOW_RIPPLE,
-    NOISE_FIELD,
-    RANDOMIZED_WORDS,
-    RAINBOW_SENTENCE,
-    TIME_COLOR_CHANGE,
-    NUM_COLOR_SCHEMES // Helper to get the count of schemes
-};
-
-// --- Animation Functions ---
-// These are called by writeWord based on the selected color scheme.
-void rainbowRipple(const Word& w, CRGB* ledArray, CHSV color);
-void noiseFieldWords(const Word& w, CRGB* ledArray, CHSV color);
-void randomizedWordColors(const Word& w, CRGB* ledArray, CHSV color);
-void rainbowSentences(const Word& w, CRGB* ledArray, CHSV color);
-void timeColorChange(const Word& w, CRGB* ledArray, CHSV color);
+#include "animation_engine.h"
+#include "color_schemes.h"
 
 // --- Full-Display Animations ---
-// These animations take over the display and are RTOS-friendly.
-void indicateNumber(CRGB* leds, uint8_t num, CHSV color);
-void wifiConnectAnimation(CRGB* leds);
+// These build animations that take over the display. They do not block;
+// start them on an AnimationStack, which the clock task ticks every frame.
+Animation indicateNumberAnimation(uint8_t num, CHSV color, uint32_t now);
+Animation wifiConnectAnimation(uint32_t now);
+Animation holdAnimation(uint32_t duration, uint32_t now);
 void writeAllWords(CRGB* ledArray, CHSV color, int rate);
 
 #endif // ANIMATIONS_H
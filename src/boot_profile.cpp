@@ -0,0 +1,38 @@
+/**
+ * @file boot_profile.cpp
+ * @brief Recording and printing of boot phase timestamps.
+ */
+
+#include "boot_profile.h"
+
+static const char* const bootPhaseNames[BOOT_PHASE_COUNT] = {
+    "setup",
+    "leds_ready",
+    "rtc_ready",
+    "time_valid",
+    "first_time_frame",
+    "epd_ready",
+    "wifi_connected",
+    "ntp_synced",
+};
+
+void markBootPhase(BootProfile& profile, BootPhase phase) {
+    if (phase >= BOOT_PHASE_COUNT || profile.at[phase] != 0) {
+        return;
+    }
+    // 0 means not reached, so a phase reached at 0 ms is stored as 1 ms
+    uint32_t now = millis();
+    profile.at[phase] = now ? now : 1;
+    Serial.printf("[Boot] %s at %u ms\n", bootPhaseNames[phase], profile.at[phase]);
+}
+
+void printBootProfile(const BootProfile& profile, Print& out) {
+    out.println("phase,ms");
+    for (uint8_t phase = 0; phase < BOOT_PHASE_COUNT; phase++) {
+        if (profile.at[phase] == 0) {
+            out.printf("%s,\n", bootPhaseNames[phase]);
+        } else {
+            out.printf("%s,%u\n", bootPhaseNames[phase], profile.at[phase]);
+        }
+    }
+}
@@ -0,0 +1,54 @@
+/**
+ * @file boot_profile.h
+ * @brief Boot ordering bits and timestamps of the boot phases.
+ *
+ * Boot state other tasks depend on is kept in bits of the boot event group
+ * instead of plain flags or fixed delays. Each phase is also timestamped once,
+ * so the time from power-on to a correct display can be checked with the
+ * console "boot" command.
+ */
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+
+// --- Boot Event Group Bits ---
+#define BOOT_RTC_READY  (1 << 0) // RTC read, system time and timezone restored; time sync waits for it
+#define BOOT_TIME_VALID (1 << 1) // The clock shows the time; NTP no longer needs to start it
+
+// Boot phases, in the order they usually happen.
+enum BootPhase : uint8_t {
+    BOOT_PHASE_SETUP,            // setup() entered
+    BOOT_PHASE_LEDS_READY,       // LED strip initialised
+    BOOT_PHASE_RTC_READY,        // RTC read
+    BOOT_PHASE_TIME_VALID,       // Clock task told the time is valid
+    BOOT_PHASE_FIRST_TIME_FRAME, // First frame showing the time drawn
+    BOOT_PHASE_EPD_READY,        // E-paper initialised
+    BOOT_PHASE_WIFI_CONNECTED,   // First WiFi connection
+    BOOT_PHASE_NTP_SYNCED,       // First NTP sync
+    BOOT_PHASE_COUNT,
+};
+
+// Milliseconds since boot at which each phase was first reached, 0 if not yet.
+struct BootProfile {
+    volatile uint32_t at[BOOT_PHASE_COUNT] = {};
+};
+
+/**
+ * @brief Records and prints the time a boot phase was reached. Later calls
+ * for the same phase are ignored.
+ * @param profile The boot profile to record into.
+ * @param phase The phase that was reached.
+ */
+void markBootPhase(BootProfile& profile, BootPhase phase);
+
+/**
+ * @brief Prints every boot phase and when it was reached, as CSV.
+ * @param profile The boot profile to print.
+ * @param out Where to print, usually Serial.
+ */
+void printBootProfile(const BootProfile& profile, Print& out);
+
+#endif // BOOT_PROFILE_H
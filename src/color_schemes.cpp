@@ -0,0 +1,244 @@
+/**
+ * @file color_schemes.cpp
+ * @brief The color scheme registry and the built-in schemes.
+ *
+ * Each scheme keeps its state in an explicit struct that is handed to its
+ * hooks, rather than in function-local statics. Colors come from 256-entry
+ * palette lookup tables rather than per-LED CHSV conversion.
+ */
+
+#include "color_schemes.h"
+#include <Arduino.h> // For random8() and map()
+#include <time.h>
+#include <string.h>
+#include "config.h"
+#include "led_geometry.h"
+#include "palettes.h"
+#include "profiler.h"
+
+// --- Registry ---
+
+static ColorSchemeOps registeredSchemes[MAX_COLOR_SCHEMES];
+static uint8_t registeredCount = 0;
+
+static void solidRender(void*, LedMask mask, const SchemeFrame& frame) {
+    CRGB color = frame.color;
+    forEachLed(mask, [&](uint8_t i) { frame.leds[i] = color; });
+}
+
+// Used for an index that has no registered scheme.
+static const ColorSchemeOps solidScheme = {"Solid", REFRESH_FULL, nullptr, solidRender, nullptr, nullptr};
+
+bool registerColorScheme(const ColorSchemeOps& scheme) {
+    if (registeredCount >= MAX_COLOR_SCHEMES || scheme.render == nullptr) {
+        return false;
+    }
+    registeredSchemes[registeredCount++] = scheme;
+    return true;
+}
+
+uint8_t colorSchemeCount() {
+    return registeredCount;
+}
+
+const ColorSchemeOps& colorScheme(uint8_t index) {
+    return (index < registeredCount) ? registeredSchemes[index] : solidScheme;
+}
+
+void renderColorScheme(uint8_t index, LedMask mask, const SchemeFrame& frame) {
+    const ColorSchemeOps& scheme = colorScheme(index);
+    PROFILE_SCOPE(PROFILE_SCHEME_RENDER, index);
+    if (scheme.beginFrame) {
+        scheme.beginFrame(scheme.state, frame);
+    }
+    scheme.render(scheme.state, mask, frame);
+    if (scheme.endFrame) {
+        scheme.endFrame(scheme.state, frame);
+    }
+}
+
+// --- Palette Ripple ---
+
+struct RippleState {
+    const CRGB* lut; // 256 colors the ripple runs through
+};
+
+static void paletteRipple(LedMask mask, CRGB* ledArray, const CRGB* lut, uint8_t base) {
+    forEachLed(mask, [&](uint8_t i) {
+        // Palette index falls off with distance from the lower left corner (Q5.3, so 8 steps per letter)
+        ledArray[i] = lut[(uint8_t)(base - ledGeometry[i].radius)];
+    });
+}
+
+void rainbowRipple(LedMask mask, CRGB* ledArray, CHSV color) {
+    paletteRipple(mask, ledArray, rainbowLut.data(), color.hue);
+}
+
+static RippleState rainbowRippleState = {rainbowLut.data()};
+
+static void rippleRender(void* state, LedMask mask, const SchemeFrame& frame) {
+    paletteRipple(mask, frame.leds, static_cast<RippleState*>(state)->lut, frame.color.hue);
+}
+
+// Pool for ripples over palettes that are only known at runtime.
+#define MAX_PALETTE_SCHEMES 2
+static CRGBPalette256 paletteLuts[MAX_PALETTE_SCHEMES];
+static RippleState paletteRippleStates[MAX_PALETTE_SCHEMES];
+static uint8_t paletteSchemeCount = 0;
+
+bool registerPaletteScheme(const char* name, const CRGBPalette16& palette) {
+    if (paletteSchemeCount >= MAX_PALETTE_SCHEMES) {
+        return false;
+    }
+    uint8_t slot = paletteSchemeCount;
+    paletteLuts[slot] = palette; // Expands the 16 entries to 256 with interpolation
+    paletteRippleStates[slot].lut = paletteLuts[slot].entries;
+    if (!registerColorScheme({name, REFRESH_FULL, nullptr, rippleRender, nullptr, &paletteRippleStates[slot]})) {
+        return false;
+    }
+    paletteSchemeCount++;
+    return true;
+}
+
+// --- Noise Field ---
+// The noise field is sampled into a grid matching the letter grid only every
+// NOISE_SLICE_MS. Frames in between blend the two nearest slices, so every
+// word reads from one coherent field at a single z per frame.
+
+#define NOISE_GRID_WIDTH  13
+#define NOISE_GRID_HEIGHT 8
+
+struct NoiseFieldState {
+    const CRGB* lut;
+    uint8_t slices[2][NOISE_GRID_HEIGHT][NOISE_GRID_WIDTH] = {}; // Earlier and later slice, [row][column]
+    uint32_t sliceTime = 0; // Time the earlier slice was sampled for
+    uint8_t blend = 0;      // How far this frame is between the two slices
+    bool initialized = false;
+};
+
+static NoiseFieldState noiseFieldState = {rainbowLut.data()};
+
+static void sampleNoiseSlice(uint8_t (&slice)[NOISE_GRID_HEIGHT][NOISE_GRID_WIDTH], uint32_t time) {
+    // 20000 noise units per letter; geometry coordinates are in 1/16 letters
+    const uint16_t scale = 1250;
+    uint32_t z = time * 20;
+    // Only the cells under an LED are ever read
+    for (uint8_t i = 0; i < NUM_LEDS; i++) {
+        if (ledWords[i] == WORD_COUNT) {
+            continue;
+        }
+        const LedGeometry& g = ledGeometry[i];
+        slice[g.y >> 4][g.x >> 4] = inoise16(g.x * scale, g.y * scale, z) >> 8;
+    }
+}
+
+static void noiseFieldBegin(void* state, const SchemeFrame& frame) {
+    auto* s = static_cast<NoiseFieldState*>(state);
+    uint32_t sliceStart = frame.now - (frame.now % NOISE_SLICE_MS);
+    if (!s->initialized || sliceStart - s->sliceTime >= 2 * NOISE_SLICE_MS) {
+        // First frame, or too long since the last one: sample both slices
+        sampleNoiseSlice(s->slices[0], sliceStart);
+        sampleNoiseSlice(s->slices[1], sliceStart + NOISE_SLICE_MS);
+        s->initialized = true;
+    } else if (sliceStart != s->sliceTime) {
+        // Moved on by one slice: the later slice becomes the earlier one
+        memcpy(s->slices[0], s->slices[1], sizeof(s->slices[0]));
+        sampleNoiseSlice(s->slices[1], sliceStart + NOISE_SLICE_MS);
+    }
+    s->sliceTime = sliceStart;
+    s->blend = ((frame.now - sliceStart) * 256) / NOISE_SLICE_MS;
+}
+
+static void noiseFieldRender(void* state, LedMask mask, const SchemeFrame& frame) {
+    auto* s = static_cast<NoiseFieldState*>(state);
+    forEachLed(mask, [&](uint8_t i) {
+        uint8_t row = ledGeometry[i].y >> 4;
+        uint8_t col = ledGeometry[i].x >> 4;
+        uint8_t noise = lerp8by8(s->slices[0][row][col], s->slices[1][row][col], s->blend);
+        frame.leds[i] = s->lut[noise];
+    });
+}
+
+// --- Randomized Word Colors ---
+
+struct RandomWordsState {
+    const CRGB* lut;
+    uint8_t wordHues[WORD_COUNT] = {}; // Indexed by WordId
+    uint32_t lastShuffle = 0; // Time the hues were last rerolled
+    bool initialized = false;
+};
+
+static RandomWordsState randomWordsState = {rainbowLut.data()};
+
+static void randomWordsBegin(void* state, const SchemeFrame& frame) {
+    auto* s = static_cast<RandomWordsState*>(state);
+    if (!s->initialized || frame.now - s->lastShuffle >= 1000) {
+        for (uint8_t& hue : s->wordHues) {
+            hue = random8();
+        }
+        s->lastShuffle = frame.now;
+        s->initialized = true;
+    }
+}
+
+static void randomWordsRender(void* state, LedMask mask, const SchemeFrame& frame) {
+    auto* s = static_cast<RandomWordsState*>(state);
+    forEachLed(mask, [&](uint8_t i) { frame.leds[i] = s->lut[s->wordHues[ledWords[i]]]; });
+}
+
+// --- Rainbow Sentence ---
+
+struct RainbowSentenceState {
+    const CRGB* lut;
+    uint8_t hue; // Palette index of the next letter in the sentence
+};
+
+static RainbowSentenceState rainbowSentenceState = {rainbowLut.data(), 0};
+
+static void rainbowSentenceBegin(void* state, const SchemeFrame& frame) {
+    // The sentence starts at the base hue and steps down the rainbow letter by letter.
+    static_cast<RainbowSentenceState*>(state)->hue = frame.color.hue;
+}
+
+static void rainbowSentenceRender(void* state, LedMask mask, const SchemeFrame& frame) {
+    auto* s = static_cast<RainbowSentenceState*>(state);
+    forEachLed(mask, [&](uint8_t i) {
+        frame.leds[i] = s->lut[s->hue];
+        s->hue -= 8;
+    });
+}
+
+// --- Time Color Change ---
+
+struct TimeColorState {
+    const CRGB* lut;
+    uint8_t dayHue; // Base palette index for the current minute of the day
+};
+
+static TimeColorState timeColorState = {rainbowLut.data(), 0};
+
+static void timeColorBegin(void* state, const SchemeFrame& frame) {
+    // This scheme changes color over 24 hours. The hue is based on the time shown.
+    static_cast<TimeColorState*>(state)->dayHue = map(frame.minuteOfDay, 0, 780, 0, 255);
+}
+
+static void timeColorRender(void* state, LedMask mask, const SchemeFrame& frame) {
+    auto* s = static_cast<TimeColorState*>(state);
+    forEachLed(mask, [&](uint8_t i) {
+        // Each word is offset from the day's hue by its position on the strip
+        frame.leds[i] = s->lut[(uint8_t)(s->dayHue + 10 * clockWords[ledWords[i]].startIndex)];
+    });
+}
+
+// --- Built-in Schemes ---
+
+void registerBuiltinColorSchemes() {
+    // Registration order is the order the color button cycles through.
+    registerColorScheme({"Rainbow ripple", REFRESH_FULL, nullptr, rippleRender, nullptr, &rainbowRippleState});
+    registerColorScheme({"Noise field", REFRESH_FULL, noiseFieldBegin, noiseFieldRender, nullptr, &noiseFieldState});
+    registerColorScheme({"Randomized words", REFRESH_LOW, randomWordsBegin, randomWordsRender, nullptr, &randomWordsState});
+    registerColorScheme({"Rainbow sentence", REFRESH_FULL, rainbowSentenceBegin, rainbowSentenceRender, nullptr, &rainbowSentenceState});
+    // The base hue drifts by one step every 60 ms, so a lower frame rate keeps up
+    registerColorScheme({"Solid color", REFRESH_LOW, nullptr, solidRender, nullptr, nullptr});
+    registerColorScheme({"Time of day", REFRESH_STATIC, timeColorBegin, timeColorRender, nullptr, &timeColorState});
+}
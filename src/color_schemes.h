@@ -0,0 +1,95 @@
+/**
+ * @file color_schemes.h
+ * @brief Registry of the color schemes used to draw the time.
+ *
+ * A color scheme is a table of hooks plus an explicit state object. For every
+ * frame the clock calls beginFrame once, render once with every lit LED, and
+ * endFrame once. Adding a scheme means writing its hooks and registering it;
+ * nothing else needs to know about it.
+ */
+#ifndef COLOR_SCHEMES_H
+#define COLOR_SCHEMES_H
+
+#include <FastLED.h>
+#include "word_layout.h"
+
+// How often a color scheme needs to be redrawn.
+enum SchemeRefresh {
+    REFRESH_STATIC, // Only when the displayed minute changes
+    REFRESH_LOW,    // At LOW_REFRESH_INTERVAL_MS
+    REFRESH_FULL,   // Every frame, at FRAME_INTERVAL_MS
+};
+
+// Everything a scheme gets to color one frame.
+struct SchemeFrame {
+    CRGB* leds;   // LED array to draw into
+    CHSV color;   // Base color, with a slowly cycling hue
+    uint32_t now; // Current time in ms
+    uint16_t minuteOfDay; // Local time being shown, minutes since midnight (0 if not the time)
+};
+
+// Hooks and state of a single color scheme. beginFrame and endFrame are optional.
+struct ColorSchemeOps {
+    const char* name;
+    SchemeRefresh refresh;
+    void (*beginFrame)(void* state, const SchemeFrame& frame);
+    void (*render)(void* state, LedMask mask, const SchemeFrame& frame);
+    void (*endFrame)(void* state, const SchemeFrame& frame);
+    void* state;
+};
+
+#define MAX_COLOR_SCHEMES 8
+
+/**
+ * @brief Adds a color scheme to the end of the list the buttons cycle through.
+ * @param scheme The scheme's hooks and state. The state must outlive the registry.
+ * @return false if the registry is full.
+ */
+bool registerColorScheme(const ColorSchemeOps& scheme);
+
+/**
+ * @brief Registers a ripple scheme that runs through the given palette.
+ *
+ * Lets themed or user-defined palettes be added without new scheme code.
+ * The palette is expanded to a 256-entry lookup table once, here.
+ * @param name Name of the scheme, for debug output.
+ * @param palette The 16-entry palette to use.
+ * @return false if no more palette schemes can be added.
+ */
+bool registerPaletteScheme(const char* name, const CRGBPalette16& palette);
+
+/**
+ * @brief Registers the schemes that ship with the clock. Call once at startup.
+ */
+void registerBuiltinColorSchemes();
+
+/**
+ * @brief Returns the number of registered color schemes.
+ */
+uint8_t colorSchemeCount();
+
+/**
+ * @brief Returns a registered scheme, or a solid color fallback for an unknown index.
+ * @param index Position in registration order.
+ */
+const ColorSchemeOps& colorScheme(uint8_t index);
+
+/**
+ * @brief Draws one frame of a color scheme over the given LEDs.
+ * @param index Position of the scheme in registration order.
+ * @param mask The LEDs to color.
+ * @param frame The LED array, base color and time for this frame.
+ */
+void renderColorScheme(uint8_t index, LedMask mask, const SchemeFrame& frame);
+
+/**
+ * @brief Colors LEDs with a rainbow that ripples out from the lower left corner.
+ *
+ * Stateless; also used directly by full-display animations.
+ * @param mask The LEDs to color.
+ * @param ledArray Pointer to the CRGB LED array.
+ * @param color The base color; its hue is the ripple's starting point.
+ */
+void rainbowRipple(LedMask mask, CRGB* ledArray, CHSV color);
+
+#endif // COLOR_SCHEMES_H
@@ -23,6 +23,16 @@
 
 
 
+// Status changes use the panel's partial update; every this many updates a
+// full refresh clears the ghosting partial updates leave behind.
+#define EPD_FULL_REFRESH_INTERVAL 10
+// Requests arriving within this long of each other are merged into one refresh,
+// but a steady stream of requests is never held back longer than the maximum.
+#define EPD_SETTLE_MS     250
+#define EPD_SETTLE_MAX_MS 2000
+// Longest a full refresh keeps EPD_BUSY high is about 4 s; give up after this
+#define EPD_BUSY_TIMEOUT_MS 6000
+
 // --- LED Strip Configuration ---
 #define DATA_PIN_WC    12
 #define LED_TYPE    WS2812B
@@ -30,10 +40,35 @@
 #define NUM_LEDS    58
 #define BRIGHTNESS  192 // Lowered for longevity and comfort
 
+// --- Frame Scheduling ---
+// The clock task only wakes as often as the active color scheme needs.
+#define FRAME_INTERVAL_MS       20  // Full rate (50Hz), also used during animations and transitions
+#define LOW_REFRESH_INTERVAL_MS 100 // For schemes that change slowly
+
+// How often the noise field color scheme samples a new slice of noise.
+// Frames in between blend the two nearest slices.
+#define NOISE_SLICE_MS 500
+
+// --- Sentence Transition Configuration ---
+// Crossfade used when the displayed sentence changes. The blend follows elapsed
+// time, so it keeps its length when the frame rate changes.
+#define TRANSITION_DURATION_MS 1500
+#define TRANSITION_EASING      EASE_IN_OUT_QUAD // EASE_LINEAR, EASE_IN_OUT_QUAD or EASE_IN_OUT_CUBIC
+
+// --- Profiling ---
+// Times writeTime(), every color scheme frame and FastLED.show() in CPU cycles,
+// per color scheme. Print the results with the console "prof" command.
+//#define WORDCLOCK_PROFILE
+
 // --- Hardware Pins ---
 #define BUTTON_1_PIN 14
 #define BUTTON_2_PIN 15
 
+// Optional: DS3231 SQW output wired to this pin (needs no pull-up, the input's is used).
+// The RTC's 1 Hz square wave then wakes the clock task on every second, instead
+// of the task working out the next minute from the system clock.
+//#define RTC_SQW_PIN 27
+
 // --- Button Timing Configuration (in milliseconds) ---
 #define SHORT_PRESS_TIME 100
 #define LONG_PRESS_TIME  1000
@@ -45,12 +80,35 @@
 #define NTP_SERVER_1    "pool.ntp.org"
 #define NTP_SERVER_2    "time.nist.gov"
 #define MAX_SYNC_RETRIES 30      // Number of times to attempt a sync before giving up
-#define RETRY_DELAY_MS   500   // Delay between failed sync attempts
+#define RETRY_DELAY_MS   500   // Delay after the first failed sync attempt, doubled after each further one
+#define SYNC_BACKOFF_MAX_MS 60000 // Longest delay between sync attempts
+#define NTP_SYNC_TIMEOUT_MS 15000 // How long to wait for SNTP to set the time
+#define TZ_REFRESH_INTERVAL_S 86400 // Refresh a cached timezone at most this often
+
+// --- RTC Drift Calibration ---
+// NTP syncs measure how far the DS3231 drifted and trim its aging offset.
+// The NTP interval grows while the RTC stays within RTC_DRIFT_TARGET_MS.
+#define RTC_DRIFT_TARGET_MS     250
+#define RTC_DRIFT_MIN_SAMPLE_S  3600  // Shorter intervals are too noisy to learn from
+#define SNTP_MIN_INTERVAL_S     3600
+#define SNTP_MAX_INTERVAL_S     86400
+// Between syncs the system clock is put back in step with the RTC this often,
+// so the calibrated DS3231 rather than the ESP32 crystal keeps the shown time.
+// Offsets below RTC_CLOCK_CHECK_MIN_MS are left alone as measurement noise.
+#define RTC_CLOCK_CHECK_INTERVAL_S 600
+#define RTC_CLOCK_CHECK_MIN_MS     5
 
 // --- Non-Volatile Storage (NVS) Keys ---
 // Used to save the timezone between reboots
 #define NVS_NAMESPACE "word_clock"
 #define NVS_TZ_KEY    "timezone"
+#define NVS_TZ_FETCHED_KEY "tz_fetched" // UTC time of the last timezone fetch
+#define NVS_TZ_NETWORK_KEY "tz_network" // Access point (BSSID) the timezone was fetched on
+#define NVS_RTC_SET_KEY    "rtc_set"    // UTC time the RTC was last set from NTP
+#define NVS_DRIFT_KEY      "rtc_drift"  // DriftEstimate blob
+#define NVS_SNTP_INTERVAL_KEY "sntp_int" // Current NTP sync interval in seconds
+// Optional user palette: 16 RGB triplets (48 bytes), added as an extra color scheme
+#define NVS_PALETTE_KEY "palette"
 \
 
 
@@ -0,0 +1,100 @@
+/**
+ * @file epd_compositor.cpp
+ * @brief Implementation of the triple-buffered e-paper compositor.
+ */
+
+#include "epd_compositor.h"
+#include <string.h>
+
+uint32_t frameHash(const GFXcanvas1& frame) {
+    const uint8_t* bytes = frame.getBuffer();
+    size_t length = ((frame.width() + 7) / 8) * frame.height();
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+void updateRows(const EpdUpdate& update, int16_t height, int16_t& top, int16_t& rows) {
+    if (update.full || update.w <= 0 || update.h <= 0) {
+        top = 0;
+        rows = height;
+        return;
+    }
+    top = max(update.y, (int16_t)0);
+    int16_t bottom = min((int16_t)(update.y + update.h), height);
+    rows = bottom > top ? bottom - top : 0;
+}
+
+bool EpdCompositor::begin() {
+    for (GFXcanvas1& frame : frames) {
+        if (!frame.getBuffer()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void EpdCompositor::present(QueueHandle_t epdQueue, EpdUpdate update) {
+    GFXcanvas1* presented = backFrame;
+    int16_t top, rows;
+    updateRows(update, presented->height(), top, rows);
+    update.presented = true;
+
+    taskENTER_CRITICAL(&lock);
+    GFXcanvas1* next = pendingFrame;
+    if (!next) {
+        // Neither drawn into, pending nor taken, so there is always one left
+        for (GFXcanvas1& frame : frames) {
+            if (&frame != presented && &frame != takenFrame) {
+                next = &frame;
+                break;
+            }
+        }
+    }
+    pendingFrame = presented;
+    mergeEpdUpdate(pendingUpdate, update);
+    taskEXIT_CRITICAL(&lock);
+
+    // Every other frame now lags the presented one in the rows just drawn
+    for (uint8_t i = 0; i < EPD_FRAME_COUNT; i++) {
+        if (&frames[i] == presented) {
+            staleTop[i] = staleBottom[i] = 0;
+        } else if (rows > 0) {
+            bool stale = staleBottom[i] > staleTop[i];
+            staleTop[i] = stale ? min(staleTop[i], top) : top;
+            staleBottom[i] = stale ? max(staleBottom[i], (int16_t)(top + rows)) : top + rows;
+        }
+    }
+
+    // Only the producer writes the back frame and the EPD task only reads
+    // the presented one, so copying between them needs no lock
+    uint8_t index = next - frames;
+    size_t rowBytes = (presented->width() + 7) / 8;
+    size_t offset = staleTop[index] * rowBytes;
+    memcpy(next->getBuffer() + offset, presented->getBuffer() + offset,
+           (staleBottom[index] - staleTop[index]) * rowBytes);
+    staleTop[index] = staleBottom[index] = 0;
+    backFrame = next;
+
+    // The area is kept in pendingUpdate too, so a full queue loses nothing
+    xQueueSend(epdQueue, &update, 0);
+}
+
+GFXcanvas1* EpdCompositor::take(EpdUpdate& update) {
+    taskENTER_CRITICAL(&lock);
+    GFXcanvas1* frame = pendingFrame;
+    update = pendingUpdate;
+    takenFrame = frame;
+    pendingFrame = nullptr;
+    pendingUpdate = {0, 0, 0, 0, false, false};
+    taskEXIT_CRITICAL(&lock);
+    return frame;
+}
+
+void EpdCompositor::release() {
+    taskENTER_CRITICAL(&lock);
+    takenFrame = nullptr;
+    taskEXIT_CRITICAL(&lock);
+}
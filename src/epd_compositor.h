@@ -0,0 +1,102 @@
+/**
+ * @file epd_compositor.h
+ * @brief Three off-screen frames for drawing e-paper content away from the panel.
+ *
+ * The producer draws into the back frame and present()s it. The frame then
+ * waits as the pending frame until the EPD task take()s it, copies it into
+ * the display's buffer and releases it. A frame presented while another is
+ * still pending replaces it, and the producer gets the replaced one back to
+ * draw into: the latest frame wins. With one frame drawn into, one pending
+ * and one read by the EPD task, present() never waits for the panel. The
+ * display buffer is only ever touched by the EPD task, so a refresh can
+ * never show a half-drawn frame.
+ *
+ * Both copies are limited to the rows that changed (see updateRows()):
+ * present() brings the new back frame up to date by copying the rows drawn
+ * since it was last presented, and the EPD task draws the rows of the taken
+ * update into the display. The display copy stays pixel by pixel through
+ * drawBitmap(): the driver's buffer is in the panel's own orientation and
+ * bit polarity, and the display runs rotated, so a canvas row is not a
+ * buffer row.
+ */
+#ifndef EPD_COMPOSITOR_H
+#define EPD_COMPOSITOR_H
+
+#include <Adafruit_GFX.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "epd_status.h"
+
+#define EPD_FRAME_COUNT 3
+
+/**
+ * @brief Returns a 32-bit FNV-1a hash of a frame's pixels.
+ * @param frame The frame to hash.
+ */
+uint32_t frameHash(const GFXcanvas1& frame);
+
+/**
+ * @brief Returns the rows of a frame an update covers, clipped to the frame.
+ *
+ * Full refreshes and updates without an area cover every row.
+ * @param update The update.
+ * @param height Height of the frame.
+ * @param top Receives the first row.
+ * @param rows Receives the number of rows, 0 if the area is off the frame.
+ */
+void updateRows(const EpdUpdate& update, int16_t height, int16_t& top, int16_t& rows);
+
+class EpdCompositor {
+public:
+    EpdCompositor(int16_t width, int16_t height)
+        : frames{GFXcanvas1(width, height), GFXcanvas1(width, height), GFXcanvas1(width, height)} {}
+
+    /**
+     * @brief Checks the frames were allocated. Call once before the tasks start.
+     * @return false if a frame buffer could not be allocated.
+     */
+    bool begin();
+
+    /**
+     * @brief Returns the frame to draw into. Only one task may draw.
+     */
+    GFXcanvas1& back() { return *backFrame; }
+
+    /**
+     * @brief Makes the back frame the pending one and takes another to draw into.
+     *
+     * The new back frame starts as a copy of the one just presented, so
+     * producers can keep drawing only what changed. Only rows drawn since the
+     * new back frame was last presented are copied, so producers must not
+     * draw outside the update. Then sends the update to the EPD task.
+     * Never blocks.
+     * @param epdQueue Queue read by the EPD task.
+     * @param update Area that changed.
+     */
+    void present(QueueHandle_t epdQueue, EpdUpdate update);
+
+    /**
+     * @brief Takes the pending frame. Only the EPD task may call this.
+     * @param update Receives the area of every frame presented since the last take().
+     * @return The frame, to be released once read; nullptr if none is pending.
+     */
+    GFXcanvas1* take(EpdUpdate& update);
+
+    /**
+     * @brief Gives back the frame from take() once the EPD task is done reading it.
+     */
+    void release();
+
+private:
+    GFXcanvas1 frames[EPD_FRAME_COUNT];
+    GFXcanvas1* backFrame = &frames[0];
+    GFXcanvas1* pendingFrame = nullptr; // Presented, not yet taken
+    GFXcanvas1* takenFrame = nullptr;   // Being read by the EPD task
+    EpdUpdate pendingUpdate = {0, 0, 0, 0, false, false};
+    // Rows each frame differs in from the last presented one; written by present() only
+    int16_t staleTop[EPD_FRAME_COUNT] = {};
+    int16_t staleBottom[EPD_FRAME_COUNT] = {};
+    portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED; // Guards the frame pointers and pendingUpdate
+};
+
+#endif // EPD_COMPOSITOR_H
@@ -0,0 +1,48 @@
+/**
+ * @file epd_panel.cpp
+ * @brief Implementation of the interrupt-driven SSD1680 busy wait.
+ */
+
+#include "epd_panel.h"
+#include "config.h"
+
+void EpdPanel::begin(bool reset) {
+    Adafruit_SSD1680::begin(reset);
+    if (_busy_pin >= 0) {
+        attachInterruptArg(_busy_pin, onBusyReleased, this, FALLING);
+    }
+}
+
+void IRAM_ATTR EpdPanel::onBusyReleased(void* arg) {
+    auto* panel = static_cast<EpdPanel*>(arg);
+    TaskHandle_t task = panel->waitingTask;
+    if (task == nullptr) {
+        return;
+    }
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(task, &xHigherPriorityTaskWoken);
+    if (xHigherPriorityTaskWoken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+void EpdPanel::busy_wait() {
+    if (_busy_pin < 0) {
+        Adafruit_SSD1680::busy_wait();
+        return;
+    }
+    // Arm before reading the pin, so an edge between the two is not missed
+    ulTaskNotifyTake(pdTRUE, 0);
+    waitingTask = xTaskGetCurrentTaskHandle();
+    uint32_t start = millis();
+    while (digitalRead(_busy_pin)) { // High while the panel is busy
+        uint32_t waited = millis() - start;
+        if (waited >= EPD_BUSY_TIMEOUT_MS) {
+            timeouts++;
+            Serial.println("[EPD] Timed out waiting for the busy line.");
+            break;
+        }
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(EPD_BUSY_TIMEOUT_MS - waited));
+    }
+    waitingTask = nullptr;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file epd_panel.h
+ * @brief The SSD1680 e-paper driver, waiting for the busy line by interrupt.
+ *
+ * The stock driver polls EPD_BUSY with delay(10) for the whole of a
+ * refresh. Here the calling task blocks on a task notification instead,
+ * given by an interrupt when the panel drops its busy line.
+ */
+#ifndef EPD_PANEL_H
+#define EPD_PANEL_H
+
+#include <Adafruit_ThinkInk.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+class EpdPanel : public Adafruit_SSD1680 {
+public:
+    using Adafruit_SSD1680::Adafruit_SSD1680;
+
+    /**
+     * @brief Initializes the driver and attaches the busy line interrupt.
+     * @param reset Passed on to the driver.
+     */
+    void begin(bool reset = true);
+
+    /**
+     * @brief Returns how many busy waits ran into EPD_BUSY_TIMEOUT_MS.
+     */
+    uint32_t busyTimeouts() const { return timeouts; }
+
+protected:
+    void busy_wait() override;
+
+private:
+    static void IRAM_ATTR onBusyReleased(void* arg);
+
+    volatile TaskHandle_t waitingTask = nullptr;
+    uint32_t timeouts = 0;
+};
+
+#endif // EPD_PANEL_H
@@ -0,0 +1,46 @@
+/**
+ * @file epd_refresh.cpp
+ * @brief Implementation of the EPD task's refresh decisions.
+ */
+
+#include "epd_refresh.h"
+#include "config.h"
+#include "epd_compositor.h"
+
+void addEpdRequest(EpdRefreshState& state, EpdUpdate& batch, const EpdUpdate& request) {
+    mergeEpdUpdate(batch, request);
+    state.requests++;
+}
+
+EpdRefresh planEpdRefresh(EpdRefreshState& state, EpdUpdate& batch, const GFXcanvas1* frame,
+                          const EpdUpdate& presented) {
+    // A frame presented just as the last batch was taken has been shown
+    // already; only the leftover request remains, with nothing to refresh
+    if (!frame && batch.presented && !batch.full) {
+        return EpdRefresh::NONE;
+    }
+    bool unchanged = false;
+    if (frame) {
+        mergeEpdUpdate(batch, presented);
+        uint32_t hash = frameHash(*frame);
+        unchanged = state.anyShown && hash == state.shownHash;
+        state.shownHash = hash;
+        state.anyShown = true;
+    }
+
+    // Redrawing the same pixels only wears the panel, unless a full refresh was asked for
+    if (unchanged && !batch.full) {
+        state.suppressed++;
+        return EpdRefresh::NONE;
+    }
+
+    // Partial updates leave ghosting behind; clear it with a full refresh now and then
+    if (batch.full || state.partialsSinceFull >= EPD_FULL_REFRESH_INTERVAL) {
+        state.partialsSinceFull = 0;
+        state.full++;
+        return EpdRefresh::FULL;
+    }
+    state.partialsSinceFull++;
+    state.partial++;
+    return EpdRefresh::PARTIAL;
+}
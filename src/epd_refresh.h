@@ -0,0 +1,53 @@
+/**
+ * @file epd_refresh.h
+ * @brief How the EPD task turns a burst of requests into one panel refresh.
+ *
+ * Requests that arrive within EPD_SETTLE_MS are merged into one batch. A
+ * batch whose frame hashes the same as the one on the panel is not
+ * refreshed, and every EPD_FULL_REFRESH_INTERVAL partial refreshes a full
+ * one clears the ghosting. None of this touches the panel, so the host
+ * simulation runs the same decisions as task_epd.
+ */
+#ifndef EPD_REFRESH_H
+#define EPD_REFRESH_H
+
+#include <Adafruit_GFX.h>
+#include "epd_status.h"
+
+enum class EpdRefresh : uint8_t {
+    NONE,    // Nothing changed on the panel
+    PARTIAL, // Refresh the batch's area
+    FULL,    // Refresh the whole panel
+};
+
+// What the EPD task remembers between batches, and what it counts.
+struct EpdRefreshState {
+    uint8_t partialsSinceFull = 0;
+    uint32_t shownHash = 0; // Of the last frame sent to the panel
+    bool anyShown = false;
+    volatile uint32_t requests = 0;   // Updates received over epdQueue
+    volatile uint32_t full = 0;
+    volatile uint32_t partial = 0;
+    volatile uint32_t suppressed = 0; // Skipped as the frame hashed the same as the one shown
+};
+
+/**
+ * @brief Adds a request received over epdQueue to the batch being collected.
+ * @param state The EPD task's refresh state.
+ * @param batch The batch; start from an empty EpdUpdate.
+ * @param request The request.
+ */
+void addEpdRequest(EpdRefreshState& state, EpdUpdate& batch, const EpdUpdate& request);
+
+/**
+ * @brief Decides how to refresh the panel for a settled batch.
+ * @param state The EPD task's refresh state.
+ * @param batch The merged requests; the frame's area is merged in here.
+ * @param frame Frame taken from EpdCompositor, nullptr if none was pending.
+ * @param presented Area of the frame, as returned by EpdCompositor::take().
+ * @return The refresh to make.
+ */
+EpdRefresh planEpdRefresh(EpdRefreshState& state, EpdUpdate& batch, const GFXcanvas1* frame,
+                          const EpdUpdate& presented);
+
+#endif // EPD_REFRESH_H
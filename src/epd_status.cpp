@@ -0,0 +1,77 @@
+/**
+ * @file epd_status.cpp
+ * @brief Implementation of the region-based e-paper status screen.
+ */
+
+#include "epd_status.h"
+#include <Adafruit_ThinkInk.h> // For EPD_WHITE and EPD_BLACK
+#include <stdarg.h>
+#include <fonts/FreeSans9pt7b.h>
+
+void EpdStatusScreen::set(StatusRegion region, const char* format, ...) {
+    char line[STATUS_TEXT_LENGTH];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+
+    if (strcmp(line, text[region]) != 0) {
+        strcpy(text[region], line);
+        dirtyRegions |= 1 << region;
+    }
+}
+
+EpdUpdate EpdStatusScreen::draw(Adafruit_GFX& gfx) {
+    EpdUpdate update = {0, 0, 0, 0, false, false};
+    int16_t top = INT16_MAX;
+    int16_t bottom = INT16_MIN;
+
+    gfx.setFont(&FreeSans9pt7b);
+    gfx.setTextWrap(false);
+    gfx.setTextColor(EPD_BLACK);
+    for (uint8_t region = 0; region < STATUS_REGION_COUNT; region++) {
+        if (!(dirtyRegions & (1 << region))) {
+            continue;
+        }
+        int16_t baseline = originY + region * STATUS_ROW_HEIGHT;
+        int16_t regionTop = max(baseline - STATUS_ASCENT, 0);
+        // Regions span the full width, so a shorter line leaves no stale pixels
+        gfx.fillRect(0, regionTop, gfx.width(), STATUS_ROW_HEIGHT, EPD_WHITE);
+        gfx.setCursor(originX, baseline);
+        gfx.print(text[region]);
+
+        top = min(top, regionTop);
+        bottom = max(bottom, (int16_t)(regionTop + STATUS_ROW_HEIGHT));
+    }
+    dirtyRegions = 0;
+
+    if (top < bottom) {
+        update.y = top;
+        update.w = gfx.width();
+        update.h = min(bottom, gfx.height()) - top;
+    }
+    return update;
+}
+
+void mergeEpdUpdate(EpdUpdate& into, const EpdUpdate& from) {
+    into.full |= from.full;
+    into.presented |= from.presented;
+    if (from.w <= 0 || from.h <= 0) {
+        return;
+    }
+    if (into.w <= 0 || into.h <= 0) {
+        into.x = from.x;
+        into.y = from.y;
+        into.w = from.w;
+        into.h = from.h;
+        return;
+    }
+    int16_t left = min(into.x, from.x);
+    int16_t top = min(into.y, from.y);
+    int16_t right = max((int16_t)(into.x + into.w), (int16_t)(from.x + from.w));
+    int16_t bottom = max((int16_t)(into.y + into.h), (int16_t)(from.y + from.h));
+    into.x = left;
+    into.y = top;
+    into.w = right - left;
+    into.h = bottom - top;
+}
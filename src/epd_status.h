@@ -0,0 +1,80 @@
+/**
+ * @file epd_status.h
+ * @brief Status screen on the e-paper display, split into fixed regions.
+ *
+ * Each region holds one line of text. Setting a region to new text marks it
+ * dirty, and draw() only repaints dirty regions, returning the rectangle
+ * that changed so the panel can refresh just that part.
+ */
+#ifndef EPD_STATUS_H
+#define EPD_STATUS_H
+
+#include <Adafruit_GFX.h>
+
+// One line each, top to bottom.
+enum StatusRegion : uint8_t {
+    STATUS_STATE, // Connection state or the current problem
+    STATUS_SSID,  // Network name
+    STATUS_IP,    // Address on the network
+    STATUS_SYNC,  // Time of the last sync
+    STATUS_REGION_COUNT,
+};
+
+#define STATUS_TEXT_LENGTH 40
+#define STATUS_ROW_HEIGHT  24 // Pixels per region, fits a FreeSans9pt7b line
+#define STATUS_ASCENT      16 // Pixels from the top of a region to the text baseline
+
+// A refresh request sent to the e-paper task over epdQueue.
+struct EpdUpdate {
+    int16_t x, y, w, h; // Area of the buffer that changed
+    bool full;          // Refresh the whole panel, e.g. to clear ghosting
+    bool presented;     // New content is waiting in EpdCompositor; false to refresh what is shown
+};
+
+/**
+ * @brief Merges one refresh request into another.
+ * @param into The pending request, grown to cover both areas.
+ * @param from The request that arrived later.
+ */
+void mergeEpdUpdate(EpdUpdate& into, const EpdUpdate& from);
+
+class EpdStatusScreen {
+public:
+    /**
+     * @param originX Left edge of the text.
+     * @param originY Baseline of the first line.
+     */
+    EpdStatusScreen(int16_t originX, int16_t originY) : originX(originX), originY(originY) {}
+
+    /**
+     * @brief Sets the text of a region, marking it dirty if it changed.
+     * @param region The region to set.
+     * @param format printf-style format of the text.
+     */
+    void set(StatusRegion region, const char* format, ...) __attribute__((format(printf, 3, 4)));
+
+    /**
+     * @brief Returns true if any region changed since the last draw().
+     */
+    bool dirty() const { return dirtyRegions != 0; }
+
+    /**
+     * @brief Repaints the dirty regions into the display buffer.
+     * @param gfx The display (or canvas) to draw into.
+     * @return The area that was repainted; w and h are 0 if nothing was dirty.
+     */
+    EpdUpdate draw(Adafruit_GFX& gfx);
+
+    /**
+     * @brief Marks every region dirty, e.g. after the buffer was cleared.
+     */
+    void invalidate() { dirtyRegions = (1 << STATUS_REGION_COUNT) - 1; }
+
+private:
+    int16_t originX;
+    int16_t originY;
+    char text[STATUS_REGION_COUNT][STATUS_TEXT_LENGTH] = {};
+    uint8_t dirtyRegions = (1 << STATUS_REGION_COUNT) - 1;
+};
+
+#endif // EPD_STATUS_H
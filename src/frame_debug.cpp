@@ -0,0 +1,125 @@
+/**
+ * @file frame_debug.cpp
+ * @brief Implements frame dumps and color scheme benchmarks.
+ */
+
+#include "frame_debug.h"
+#include "config.h"
+#include "color_schemes.h"
+#include "led_geometry.h"
+#include "time_display.h"
+#include "time_golden.h"
+
+#define GRID_WIDTH  13
+#define GRID_HEIGHT 8
+#define BENCHMARK_FRAMES 500
+
+// Fills a grid of LED indices, -1 for cells with no LED. Row 0 is the top row.
+static void mapGrid(int8_t (&grid)[GRID_HEIGHT][GRID_WIDTH]) {
+    memset(grid, -1, sizeof(grid));
+    for (uint8_t i = 0; i < NUM_LEDS; i++) {
+        if (ledWords[i] == WORD_COUNT) {
+            continue;
+        }
+        uint8_t col = ledGeometry[i].x >> 4;
+        uint8_t row = ledGeometry[i].y >> 4;
+        grid[GRID_HEIGHT - 1 - row][col] = i;
+    }
+}
+
+void printFrameAscii(const CRGB* leds, Print& out) {
+    static const char shades[] = " .:-=+*#%@";
+    int8_t grid[GRID_HEIGHT][GRID_WIDTH];
+    mapGrid(grid);
+
+    for (uint8_t row = 0; row < GRID_HEIGHT; row++) {
+        char line[GRID_WIDTH + 1];
+        for (uint8_t col = 0; col < GRID_WIDTH; col++) {
+            int8_t led = grid[row][col];
+            if (led < 0) {
+                line[col] = ' ';
+                continue;
+            }
+            uint8_t level = max(leds[led].r, max(leds[led].g, leds[led].b));
+            // Unlit LEDs show as '_' so they can be told apart from gaps in the grid
+            line[col] = level ? shades[1 + (level * (sizeof(shades) - 3)) / 255] : '_';
+        }
+        line[GRID_WIDTH] = '\0';
+        out.println(line);
+    }
+}
+
+void printFramePpm(const CRGB* leds, Print& out) {
+    int8_t grid[GRID_HEIGHT][GRID_WIDTH];
+    mapGrid(grid);
+
+    out.printf("P3\n%d %d\n255\n", GRID_WIDTH, GRID_HEIGHT);
+    for (uint8_t row = 0; row < GRID_HEIGHT; row++) {
+        for (uint8_t col = 0; col < GRID_WIDTH; col++) {
+            int8_t led = grid[row][col];
+            CRGB c = (led < 0) ? CRGB(CRGB::Black) : leds[led];
+            out.printf("%d %d %d ", c.r, c.g, c.b);
+        }
+        out.println();
+    }
+}
+
+void benchmarkColorSchemes(Print& out) {
+    CRGB scratch[NUM_LEDS];
+    LedMask allWords = 0;
+    for (const Word& w : clockWords) {
+        allWords |= wordMask(w);
+    }
+
+    out.println("scheme,name,frames,ns_per_frame,heap_delta_bytes");
+    for (uint8_t index = 0; index < colorSchemeCount(); index++) {
+        uint32_t now = millis();
+        uint32_t heapBefore = ESP.getFreeHeap();
+        uint32_t start = micros();
+        for (uint16_t f = 0; f < BENCHMARK_FRAMES; f++) {
+            // Advance simulated time by one full-rate frame per render, from 10:00
+            uint32_t elapsedMs = f * FRAME_INTERVAL_MS;
+            uint16_t minuteOfDay = 10 * 60 + elapsedMs / 60000;
+            SchemeFrame frame = {scratch, CHSV(f, 255, 255), now + elapsedMs, minuteOfDay};
+            renderColorScheme(index, allWords, frame);
+        }
+        uint32_t elapsed = micros() - start;
+        int32_t heapDelta = (int32_t)heapBefore - (int32_t)ESP.getFreeHeap();
+        out.printf("%u,%s,%u,%u,%d\n", index, colorScheme(index).name, BENCHMARK_FRAMES,
+                   (uint32_t)((uint64_t)elapsed * 1000 / BENCHMARK_FRAMES), heapDelta);
+    }
+}
+
+void benchmarkDay(Print& out) {
+    CRGB scratch[NUM_LEDS];
+
+    out.println("scheme,name,minutes,total_us,us_per_minute,mismatches");
+    for (uint8_t index = 0; index < colorSchemeCount(); index++) {
+        MaskTransition transition;
+        uint16_t mismatches = 0;
+        uint32_t start = micros();
+        for (uint16_t minuteOfDay = 0; minuteOfDay < 24 * 60; minuteOfDay++) {
+            int hours = minuteOfDay / 60;
+            int minutes = minuteOfDay % 60;
+            // Simulated time advances one minute per step; render the first
+            // frame of the crossfade and the settled frame after it.
+            uint32_t now = (uint32_t)minuteOfDay * 60000;
+            CHSV color(minuteOfDay, 255, 255);
+            writeTime(hours, minutes, scratch, color, index, transition, now);
+            writeTime(hours, minutes, scratch, color, index, transition, now + transition.durationMs);
+
+            LedMask lit = 0;
+            for (uint8_t i = 0; i < NUM_LEDS; i++) {
+                if (scratch[i]) {
+                    lit |= 1ULL << i;
+                }
+            }
+            if (lit != goldenTimeMasks[hours][minutes / 5]) {
+                mismatches++;
+            }
+        }
+        uint32_t elapsed = micros() - start;
+        out.printf("%u,%s,%u,%u,%u,%u\n", index, colorScheme(index).name, 24 * 60,
+                   elapsed, elapsed / (24 * 60), mismatches);
+    }
+}
@@ -0,0 +1,49 @@
+/**
+ * @file frame_debug.h
+ * @brief Debug output of LED frames and color scheme benchmarks.
+ *
+ * Frames are laid out on the letter grid using the word coordinates, so a
+ * dump shows what the clock face looks like rather than the strip order.
+ */
+#ifndef FRAME_DEBUG_H
+#define FRAME_DEBUG_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+/**
+ * @brief Prints a frame as an ASCII grid, one character per LED by brightness.
+ * @param leds Pointer to the CRGB LED array.
+ * @param out Where to print, usually Serial.
+ */
+void printFrameAscii(const CRGB* leds, Print& out);
+
+/**
+ * @brief Prints a frame as a plain-text PPM (P3) image of the letter grid.
+ * @param leds Pointer to the CRGB LED array.
+ * @param out Where to print, usually Serial.
+ */
+void printFramePpm(const CRGB* leds, Print& out);
+
+/**
+ * @brief Renders every registered color scheme into a scratch frame and prints
+ * the time and heap change per frame as CSV.
+ *
+ * Must run in the clock task, which owns the scheme state.
+ * @param out Where to print, usually Serial.
+ */
+void benchmarkColorSchemes(Print& out);
+
+/**
+ * @brief Renders every minute of a simulated day with every registered color
+ * scheme and prints the total render time per scheme as CSV.
+ *
+ * The lit LEDs of each settled frame are checked against goldenTimeMasks, so
+ * the mismatches column should always be 0. A scheme that draws black over
+ * a lit word (e.g. a dark user palette) also shows up there. Must run in the
+ * clock task, which owns the scheme state.
+ * @param out Where to print, usually Serial.
+ */
+void benchmarkDay(Print& out);
+
+#endif // FRAME_DEBUG_H
@@ -0,0 +1,115 @@
+/**
+ * @file led_geometry.h
+ * @brief Compile-time table of per-LED positions on the clock face.
+ *
+ * The tables are derived from clockWords at compile time and live in flash,
+ * so animations can look up where an LED sits instead of computing distances
+ * with floating point math every frame.
+ */
+#ifndef LED_GEOMETRY_H
+#define LED_GEOMETRY_H
+
+#include <stdint.h>
+#include "config.h"
+#include "word_layout.h"
+
+// Position of a single LED. All fields are 8-bit fixed point:
+//   x, y    grid column and row in Q4.4 (1/16 of a letter pitch)
+//   radius  distance from the lower left corner in Q5.3, with rows stretched
+//           by 1.6 to match the aspect ratio of the letters
+//   angle   direction from the lower left corner, 256 steps per full turn
+struct LedGeometry {
+    uint8_t x;
+    uint8_t y;
+    uint8_t radius;
+    uint8_t angle;
+};
+
+namespace led_geometry_detail {
+
+// Integer square root, rounded down.
+constexpr uint32_t isqrt(uint32_t n) {
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > n) bit >>= 2;
+    while (bit != 0) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+// atan(n / d) for 0 <= n <= d, in 256ths of a turn.
+// Uses atan(t) ~= t * pi/4 + 0.273 * t * (1 - t), good to about 0.1 step.
+constexpr uint32_t atanOctant(uint32_t n, uint32_t d) {
+    if (d == 0) return 0;
+    return (3200 * n * d + 1112 * n * (d - n) + 50 * d * d) / (100 * d * d);
+}
+
+// Direction of (x, y) in the first quadrant, in 256ths of a turn.
+constexpr uint8_t angle256(uint32_t x, uint32_t y) {
+    return (y <= x) ? atanOctant(y, x) : 64 - atanOctant(x, y);
+}
+
+struct LedGeometryTable {
+    LedGeometry led[NUM_LEDS];
+
+    constexpr const LedGeometry& operator[](uint8_t index) const { return led[index]; }
+};
+
+constexpr LedGeometryTable buildLedGeometry() {
+    LedGeometryTable table{};
+    for (const Word& w : clockWords) {
+        for (uint8_t i = 0; i < w.wordLength; i++) {
+            uint32_t col = w.x + i;
+            uint32_t row = w.y;
+            // Scaled by 10 so the 1.6 row stretch stays in integers: 8 * col and 12.8 * row.
+            uint32_t sx = 80 * col;
+            uint32_t sy = 128 * row;
+            LedGeometry& g = table.led[w.startIndex + i];
+            g.x = col << 4;
+            g.y = row << 4;
+            g.radius = isqrt(sx * sx + sy * sy) / 10;
+            g.angle = angle256(sx, sy);
+        }
+    }
+    return table;
+}
+
+struct LedWordTable {
+    WordId word[NUM_LEDS];
+
+    constexpr WordId operator[](uint8_t index) const { return word[index]; }
+};
+
+constexpr LedWordTable buildLedWords() {
+    LedWordTable table{};
+    for (WordId& id : table.word) {
+        id = WORD_COUNT;
+    }
+    for (uint8_t k = 0; k < WORD_COUNT; k++) {
+        for (uint8_t i = 0; i < clockWords[k].wordLength; i++) {
+            table.word[clockWords[k].startIndex + i] = static_cast<WordId>(k);
+        }
+    }
+    return table;
+}
+
+} // namespace led_geometry_detail
+
+// Geometry of every LED, indexed by LED number. LEDs not covered by a word stay zeroed.
+inline constexpr led_geometry_detail::LedGeometryTable ledGeometry = led_geometry_detail::buildLedGeometry();
+
+// Word each LED belongs to, indexed by LED number. WORD_COUNT for LEDs not covered by a word.
+inline constexpr led_geometry_detail::LedWordTable ledWords = led_geometry_detail::buildLedWords();
+
+static_assert(ledGeometry[54].radius == 40, "O'CLOCK starts 5 columns right of the origin");
+static_assert(ledGeometry[1].radius == 89, "IT sits 7 stretched rows above the origin");
+static_assert(ledWords[57] == WORD_OCLOCK, "O'CLOCK is the last word on the strip");
+
+#endif // LED_GEOMETRY_H
@@ -0,0 +1,73 @@
+/**
+ * @file local_time.cpp
+ * @brief Implementation of the cached local time conversion.
+ */
+
+#include "local_time.h"
+
+#define SECONDS_PER_DAY 86400L
+// DST rules change the offset at most a few times a year, never twice a week.
+#define TRANSITION_PROBE_STEP (7 * SECONDS_PER_DAY)
+// Zones without DST are rechecked about once a year.
+#define TRANSITION_SEARCH_LIMIT (400 * SECONDS_PER_DAY)
+
+// Days since 1970-01-01 of a proleptic Gregorian date (month 1-12).
+static int32_t daysFromCivil(int32_t year, uint32_t month, uint32_t day) {
+    year -= month <= 2;
+    int32_t era = (year >= 0 ? year : year - 399) / 400;
+    uint32_t yearOfEra = year - era * 400;
+    uint32_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    uint32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + (int32_t)dayOfEra - 719468;
+}
+
+// Offset of local time from UTC at the given instant, the slow way.
+static int32_t localOffset(time_t utc) {
+    struct tm local;
+    localtime_r(&utc, &local);
+    int64_t localSeconds = (int64_t)daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday) * SECONDS_PER_DAY
+                         + local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec;
+    return (int32_t)(localSeconds - utc);
+}
+
+void LocalTimeCache::refresh(time_t utc, uint32_t tzGeneration) {
+    utcOffset = localOffset(utc);
+    validFrom = utc;
+    validUntil = utc + TRANSITION_SEARCH_LIMIT;
+    generation = tzGeneration;
+    valid = true;
+
+    // Step forward a week at a time until the offset changes, then bisect
+    // down to the second it changes at.
+    for (time_t probe = utc; probe < utc + TRANSITION_SEARCH_LIMIT; probe += TRANSITION_PROBE_STEP) {
+        time_t next = probe + TRANSITION_PROBE_STEP;
+        if (localOffset(next) == utcOffset) {
+            continue;
+        }
+        time_t before = probe;
+        while (next - before > 1) {
+            time_t middle = before + (next - before) / 2;
+            if (localOffset(middle) == utcOffset) {
+                before = middle;
+            } else {
+                next = middle;
+            }
+        }
+        validUntil = next;
+        break;
+    }
+}
+
+int32_t LocalTimeCache::offset(time_t utc, uint32_t tzGeneration) {
+    // Also refresh when the clock was set back to before the cached range
+    if (!valid || tzGeneration != generation || utc < validFrom || utc >= validUntil) {
+        refresh(utc, tzGeneration);
+    }
+    return utcOffset;
+}
+
+uint32_t LocalTimeCache::secondOfDay(time_t utc, uint32_t tzGeneration) {
+    int64_t local = (int64_t)utc + offset(utc, tzGeneration);
+    int32_t second = local % SECONDS_PER_DAY;
+    return second < 0 ? second + SECONDS_PER_DAY : second;
+}
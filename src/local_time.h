@@ -0,0 +1,42 @@
+/**
+ * @file local_time.h
+ * @brief Cached UTC to local time conversion.
+ *
+ * localtime_r() runs newlib's POSIX TZ rule logic on every call, although the
+ * offset from UTC only changes at daylight saving transitions. The cache works
+ * out the current offset and the instant of the next transition once, so each
+ * frame only needs an addition and a range check.
+ */
+#ifndef LOCAL_TIME_H
+#define LOCAL_TIME_H
+
+#include <Arduino.h>
+#include <time.h>
+
+class LocalTimeCache {
+public:
+    /**
+     * @brief Returns the local time as seconds since local midnight.
+     * @param utc Current time, seconds since the epoch.
+     * @param tzGeneration Current AppContext::tz_generation; a change drops the cache.
+     */
+    uint32_t secondOfDay(time_t utc, uint32_t tzGeneration);
+
+    /**
+     * @brief Returns the offset of local time from UTC in seconds.
+     * @param utc Current time, seconds since the epoch.
+     * @param tzGeneration Current AppContext::tz_generation; a change drops the cache.
+     */
+    int32_t offset(time_t utc, uint32_t tzGeneration);
+
+private:
+    void refresh(time_t utc, uint32_t tzGeneration);
+
+    bool valid = false;
+    uint32_t generation = 0;
+    time_t validFrom = 0;  // The offset holds from here...
+    time_t validUntil = 0; // ...up to, not including, the next transition
+    int32_t utcOffset = 0;
+};
+
+#endif // LOCAL_TIME_H
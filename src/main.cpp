@@ -4,6 +4,9 @@
  *
  * Initializes the central AppContext, hardware, and FreeRTOS tasks.
  * The AppContext is passed to each task to provide access to shared resources.
+ * The WiFi task starts connecting before the time is restored from the RTC;
+ * its first time sync waits for BOOT_RTC_READY in the boot event group, set
+ * once the system clock is in phase with the RTC.
  */
 
 #include "config.h"
@@ -11,6 +14,10 @@
 #include "tasks/clock_task.h"
 #include "tasks/button_task.h"
 #include "tasks/wifi_task.h"
+#include "tasks/console_task.h"
+#include "color_schemes.h"
+#include "palettes.h"
+#include "rtc_time.h"
 #include <time.h>
 #include <TimeLib.h>
 #include <sys/time.h>
@@ -22,17 +29,19 @@
 AppContext appContext;
 
 // --- Task Handles ---
-TaskHandle_t clockTaskHandle;
 TaskHandle_t buttonTaskHandle;
 TaskHandle_t wifiTaskHandle;
 TaskHandle_t heapTaskHandle;
 TaskHandle_t epdTaskHandle;
+TaskHandle_t consoleTaskHandle;
 
 // --- Forward Declarations ---
 void log_heap_status();
+void log_frame_stats();
 void taskLogHeap(void *pvParameters);
 void WiFiEvent(WiFiEvent_t event);
 void SNTPEvent(struct timeval *tv);
+void RtcSqwEvent();
 
 void setup()
 {
@@ -40,6 +49,7 @@ void setup()
     pinMode(BUTTON_2_PIN, INPUT_PULLUP);
     Serial.begin(115200);
     Serial.println("\n--- Word Clock Starting Up ---");
+    markBootPhase(appContext.boot_profile, BOOT_PHASE_SETUP);
 
     // Initialize Preferences from the context
     appContext.preferences.begin(NVS_NAMESPACE, false);
@@ -47,9 +57,11 @@ void setup()
     // Initialize Queues in the context
     appContext.systemCommandQueue = xQueueCreate(5, sizeof(SystemCommand));
     appContext.networkEventQueue = xQueueCreate(5, sizeof(NetworkEvent_t));
-    appContext.epdQueue = xQueueCreate(5, 0); // Queue for signaling EPD updates
+    appContext.epdQueue = xQueueCreate(5, sizeof(EpdUpdate)); // Queue for signaling EPD updates
+    appContext.bootEvents = xEventGroupCreate();
 
-    if (!appContext.systemCommandQueue || !appContext.networkEventQueue || !appContext.epdQueue)
+    if (!appContext.systemCommandQueue || !appContext.networkEventQueue || !appContext.epdQueue || !appContext.bootEvents ||
+        !appContext.epd_frames.begin())
     {
         Serial.println("[ERROR] Failed to create one or more queues! Halting.");
         while (1)
@@ -67,34 +79,64 @@ void setup()
         xQueueSend(appContext.networkEventQueue, &evt, 0);
     }
 
+    // Register the color schemes the clock can cycle through
+    registerBuiltinColorSchemes();
+    CRGBPalette16 userPalette;
+    if (loadUserPalette(appContext.preferences, userPalette))
+    {
+        registerPaletteScheme("User palette", userPalette);
+        Serial.println("User palette loaded from NVS.");
+    }
+
     // Initialize LED Strip using the 'leds' array in the context
     FastLED.addLeds<LED_TYPE, DATA_PIN_WC, COLOR_ORDER>(appContext.leds, NUM_LEDS).setCorrection(TypicalLEDStrip);
     FastLED.setBrightness(BRIGHTNESS);
     FastLED.clear();
     FastLED.show();
+    markBootPhase(appContext.boot_profile, BOOT_PHASE_LEDS_READY);
 
     Serial.println("--- Initial Heap Status ---");
     log_heap_status(); // Log once at startup for immediate feedback
     Serial.println("---------------------------");
 
-    // Create Tasks, passing a pointer to the global AppContext to each one
+    // Create Tasks, passing a pointer to the global AppContext to each one.
+    // The e-paper initialises on core 0 while the clock starts on core 1.
     xTaskCreatePinnedToCore(task_epd, "Epaper Task", 16535, &appContext, 2, &epdTaskHandle, 0);
-    vTaskDelay(5000);
-    
-    //vTaskDelay(10000);
-    xTaskCreatePinnedToCore(taskLogHeap, "Heap Logger", 2048, NULL, 0, &heapTaskHandle, 1);
-    xTaskCreatePinnedToCore(taskClockUpdate, "Clock Task", 4096, &appContext, 5, &clockTaskHandle, 1);
-    xTaskCreatePinnedToCore(taskButtonCheck, "Button Task", 2048, &appContext, 3, &buttonTaskHandle, 1);
-    //vTaskDelay(30000);
-    // WiFi Event Handler Setup
+    xTaskCreatePinnedToCore(taskClockUpdate, "Clock Task", 4096, &appContext, 5, &appContext.clockTask, 1);
+
+    // Start connecting to WiFi now; the first time sync waits for BOOT_RTC_READY
     WiFi.onEvent(WiFiEvent);
     sntp_set_time_sync_notification_cb(SNTPEvent);
     xTaskCreatePinnedToCore(taskWiFi, "WiFi Task", 16535, &appContext, 1, &wifiTaskHandle, 0);
-    Serial.println("Setup complete. Tasks are running.");
-
-    // Trigger initial WiFi connection process
     NetworkEvent_t bootEvt = NetworkEvent_t::WIFI_BOOT;
     xQueueSend(appContext.networkEventQueue, &bootEvt, portMAX_DELAY);
+
+    // Restore the time from the RTC right away; the clock task shows it as soon
+    // as START_CLOCK_DISPLAY arrives, without waiting for WiFi or the e-paper.
+    restoreTimezone(&appContext);
+    bool rtcValid = initializeFromRtc(&appContext);
+    markBootPhase(appContext.boot_profile, BOOT_PHASE_RTC_READY);
+
+#ifdef RTC_SQW_PIN
+    // Wake the clock task on every RTC second instead of polling the system clock
+    appContext.rtc.writeSqwPinMode(DS3231_SquareWave1Hz);
+    pinMode(RTC_SQW_PIN, INPUT_PULLUP); // SQW is open drain
+    attachInterrupt(digitalPinToInterrupt(RTC_SQW_PIN), RtcSqwEvent, FALLING);
+#endif
+
+    xTaskCreatePinnedToCore(taskLogHeap, "Heap Logger", 2048, NULL, 0, &heapTaskHandle, 1);
+    xTaskCreatePinnedToCore(taskButtonCheck, "Button Task", 2048, &appContext, 3, &buttonTaskHandle, 1);
+    xTaskCreatePinnedToCore(taskConsole, "Console Task", 2048, &appContext, 1, &consoleTaskHandle, 1);
+
+    // The clock already shows the time; bring the system clock into phase with
+    // the RTC on its next tick. Time sync waits for this, so NTP is not undone.
+    if (rtcValid)
+    {
+        alignSystemClockToRtc(&appContext);
+    }
+    xEventGroupSetBits(appContext.bootEvents, BOOT_RTC_READY);
+    //vTaskDelay(30000);
+    Serial.println("Setup complete. Tasks are running.");
 }
 
 void loop()
@@ -112,6 +154,25 @@ void log_heap_status()
                   ESP.getMinFreeHeap());
 }
 
+// --- LED Frame Logging Helper Function ---
+// Compares frames drawn by the clock task with frames actually sent to the strip,
+// and reports how often the clock task woke up since the last call.
+void log_frame_stats()
+{
+    static uint32_t lastWakeups = 0;
+    static uint32_t lastMillis = 0;
+    uint32_t wakeups = appContext.clock_wakeups;
+    uint32_t now = millis();
+    float wakeupsPerSecond = (now != lastMillis) ? (wakeups - lastWakeups) * 1000.0f / (now - lastMillis) : 0.0f;
+    lastWakeups = wakeups;
+    lastMillis = now;
+
+    Serial.printf("[LED] Frames rendered: %u | Frames pushed: %u | Clock wakeups/s: %.1f\n",
+                  appContext.frames_rendered,
+                  appContext.frames_pushed,
+                  wakeupsPerSecond);
+}
+
 // --- Heap Logging Task ---
 // A simple periodic task to monitor memory usage.
 void taskLogHeap(void *pvParameters)
@@ -119,6 +180,7 @@ void taskLogHeap(void *pvParameters)
     for (;;)
     {
         log_heap_status();
+        log_frame_stats();
         vTaskDelay(pdMS_TO_TICKS(15000)); // Log every 15 seconds
     }
 }
@@ -156,4 +218,20 @@ void SNTPEvent(struct timeval *tv)
     NetworkEvent_t evt;
     evt = NetworkEvent_t::SNTP_SYNC;
     xQueueSendFromISR(appContext.networkEventQueue, &evt, &xHigherPriorityTaskWoken);
-}
\ No newline at end of file
+}
+
+// --- RTC Square Wave Handler ---
+// Interrupt on the falling edge of the DS3231's 1 Hz output, which is when its
+// seconds register updates. Only attached when RTC_SQW_PIN is defined.
+// The tick wakes the clock task by notification, so a busy clock task lets
+// ticks pile up in its notification count, not in the command queue.
+void IRAM_ATTR RtcSqwEvent()
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    appContext.rtc_edge_us = micros();
+    vTaskNotifyGiveFromISR(appContext.clockTask, &xHigherPriorityTaskWoken);
+    if (xHigherPriorityTaskWoken)
+    {
+        portYIELD_FROM_ISR();
+    }
+}
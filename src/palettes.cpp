@@ -0,0 +1,50 @@
+/**
+ * @file palettes.cpp
+ * @brief Lookup tables and NVS storage for color palettes.
+ */
+
+#include "palettes.h"
+#include "config.h"
+#include <utility>
+
+namespace {
+
+// RainbowColors_p; FastLED's copy is not usable in constant expressions
+constexpr uint32_t rainbowColors[16] = {
+    0xFF0000, 0xD52A00, 0xAB5500, 0xAB7F00, 0xABAB00, 0x56D500, 0x00FF00, 0x00D52A,
+    0x00AB55, 0x0056AA, 0x0000FF, 0x2A00D5, 0x5500AB, 0x7F0081, 0xAB0055, 0xD5002B,
+};
+
+constexpr uint8_t lutScale8(uint8_t i, uint8_t scale) { return ((uint16_t)i * (1 + scale)) >> 8; }
+
+// One channel of ColorFromPalette(RainbowColors_p, index), with the same
+// 8-bit blend as CRGBPalette256's expansion, so the table matches it exactly.
+constexpr uint8_t rainbowChannel(uint8_t index, uint8_t shift) {
+    uint8_t from = rainbowColors[index >> 4] >> shift;
+    uint8_t to = rainbowColors[((index >> 4) + 1) & 0x0F] >> shift;
+    uint8_t f2 = (index & 0x0F) << 4;
+    return f2 ? (uint8_t)(lutScale8(from, 255 - f2) + lutScale8(to, f2)) : from;
+}
+
+template <size_t... Index>
+constexpr std::array<CRGB, 256> expandRainbow(std::index_sequence<Index...>) {
+    return {{CRGB(rainbowChannel(Index, 16), rainbowChannel(Index, 8), rainbowChannel(Index, 0))...}};
+}
+
+} // namespace
+
+constexpr std::array<CRGB, 256> rainbowLut = expandRainbow(std::make_index_sequence<256>());
+
+bool loadUserPalette(Preferences& prefs, CRGBPalette16& palette) {
+    uint8_t rgb[16 * 3];
+    if (prefs.getBytesLength(NVS_PALETTE_KEY) != sizeof(rgb)) {
+        return false;
+    }
+    if (prefs.getBytes(NVS_PALETTE_KEY, rgb, sizeof(rgb)) != sizeof(rgb)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < 16; i++) {
+        palette[i] = CRGB(rgb[3 * i], rgb[3 * i + 1], rgb[3 * i + 2]);
+    }
+    return true;
+}
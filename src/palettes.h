@@ -0,0 +1,31 @@
+/**
+ * @file palettes.h
+ * @brief Precomputed color lookup tables for the color schemes.
+ *
+ * Schemes look colors up in 256-entry tables that are expanded, with
+ * fixed-point interpolation, from 16-entry palettes. This replaces a CHSV to
+ * RGB conversion per LED per frame with a table read. The rainbow table is
+ * expanded by the compiler and lives in flash; user palettes are expanded
+ * into RAM when they are registered.
+ */
+#ifndef PALETTES_H
+#define PALETTES_H
+
+#include <FastLED.h>
+#include <Preferences.h>
+#include <array>
+
+// Rainbow lookup table, expanded from RainbowColors_p at compile time. Index is the hue.
+extern const std::array<CRGB, 256> rainbowLut;
+
+/**
+ * @brief Reads a user-defined palette from NVS.
+ *
+ * The palette is stored under NVS_PALETTE_KEY as 16 RGB triplets (48 bytes).
+ * @param prefs Preferences opened on the clock's NVS namespace.
+ * @param palette Receives the palette if one is stored.
+ * @return true if a valid palette was found.
+ */
+bool loadUserPalette(Preferences& prefs, CRGBPalette16& palette);
+
+#endif // PALETTES_H
@@ -0,0 +1,115 @@
+/**
+ * @file profiler.cpp
+ * @brief Histogram storage and serial report for the cycle-count profiler.
+ *
+ * All samples are recorded and printed by the clock task, so no locking is needed.
+ */
+
+#include "profiler.h"
+#include "color_schemes.h"
+
+#ifdef WORDCLOCK_PROFILE
+
+static const char* const sectionNames[PROFILE_SECTION_COUNT] = {
+    "write_time",
+    "scheme_render",
+    "led_show",
+};
+
+// Each power of two is split into 4 buckets; samples of 7 * 2^22 cycles and
+// more (122ms at 240MHz) all land in the last bucket.
+#define PROFILE_SUB_BUCKETS  4
+#define PROFILE_BUCKETS      (24 * PROFILE_SUB_BUCKETS)
+
+struct CycleHistogram {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t buckets[PROFILE_BUCKETS]; // As wide as count, so percentile ranks stay in step
+};
+
+static CycleHistogram histograms[PROFILE_SECTION_COUNT][MAX_COLOR_SCHEMES];
+
+static uint8_t bucketOf(uint32_t cycles) {
+    if (cycles < PROFILE_SUB_BUCKETS) {
+        return cycles;
+    }
+    uint8_t exponent = 31 - __builtin_clz(cycles);
+    uint8_t sub = (cycles >> (exponent - 2)) & (PROFILE_SUB_BUCKETS - 1);
+    uint16_t bucket = (exponent - 1) * PROFILE_SUB_BUCKETS + sub;
+    return min(bucket, (uint16_t)(PROFILE_BUCKETS - 1));
+}
+
+// Largest sample that falls into a bucket
+static uint32_t bucketLimit(uint8_t bucket) {
+    if (bucket < PROFILE_SUB_BUCKETS) {
+        return bucket;
+    }
+    if (bucket == PROFILE_BUCKETS - 1) {
+        return UINT32_MAX;
+    }
+    uint8_t exponent = bucket / PROFILE_SUB_BUCKETS + 1;
+    uint8_t sub = bucket % PROFILE_SUB_BUCKETS;
+    return ((PROFILE_SUB_BUCKETS + sub + 1) << (exponent - 2)) - 1;
+}
+
+static uint32_t percentile(const CycleHistogram& h, uint8_t percent) {
+    uint32_t rank = ((uint64_t)h.count * percent + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t bucket = 0; bucket < PROFILE_BUCKETS; bucket++) {
+        seen += h.buckets[bucket];
+        if (seen >= rank) {
+            // The bucket limit can overshoot the largest sample actually seen
+            return min(bucketLimit(bucket), h.max);
+        }
+    }
+    return h.max;
+}
+
+void profileRecord(ProfileSection section, uint8_t scheme, uint32_t cycles) {
+    if (section >= PROFILE_SECTION_COUNT || scheme >= MAX_COLOR_SCHEMES) {
+        return;
+    }
+    CycleHistogram& h = histograms[section][scheme];
+    if (h.count == 0 || cycles < h.min) {
+        h.min = cycles;
+    }
+    if (cycles > h.max) {
+        h.max = cycles;
+    }
+    h.count++;
+    h.total += cycles;
+    h.buckets[bucketOf(cycles)]++;
+}
+
+void printProfile(Print& out) {
+    out.printf("cpu_mhz,%u\n", getCpuFrequencyMhz());
+    out.println("section,scheme,name,count,min_cycles,avg_cycles,p99_cycles,max_cycles");
+    for (uint8_t section = 0; section < PROFILE_SECTION_COUNT; section++) {
+        for (uint8_t scheme = 0; scheme < colorSchemeCount(); scheme++) {
+            const CycleHistogram& h = histograms[section][scheme];
+            if (h.count == 0) {
+                continue;
+            }
+            out.printf("%s,%u,%s,%u,%u,%u,%u,%u\n", sectionNames[section], scheme, colorScheme(scheme).name,
+                       h.count, h.min, (uint32_t)(h.total / h.count), percentile(h, 99), h.max);
+        }
+    }
+}
+
+void resetProfile() {
+    memset(histograms, 0, sizeof(histograms));
+}
+
+#else
+
+void profileRecord(ProfileSection, uint8_t, uint32_t) {}
+
+void printProfile(Print& out) {
+    out.println("Profiling is off. Build with WORDCLOCK_PROFILE defined to enable it.");
+}
+
+void resetProfile() {}
+
+#endif // WORDCLOCK_PROFILE
@@ -0,0 +1,63 @@
+/**
+ * @file profiler.h
+ * @brief Cycle-count profiler for the LED rendering path.
+ *
+ * Built only with WORDCLOCK_PROFILE defined; otherwise PROFILE_SCOPE compiles
+ * to nothing and the console "prof" command says profiling is off. Samples
+ * are kept per color scheme in log-scale histograms, so p99 comes out within
+ * 25% of the true value without storing every sample.
+ */
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Parts of the render path that are timed.
+enum ProfileSection : uint8_t {
+    PROFILE_WRITE_TIME,    // writeTime(), including the crossfade
+    PROFILE_SCHEME_RENDER, // One color scheme frame: beginFrame, render, endFrame
+    PROFILE_LED_SHOW,      // FastLED.show()
+    PROFILE_SECTION_COUNT,
+};
+
+/**
+ * @brief Adds one sample to the histogram of a section and color scheme.
+ * @param section The part of the render path that was timed.
+ * @param scheme Index of the active color scheme.
+ * @param cycles Duration in CPU cycles.
+ */
+void profileRecord(ProfileSection section, uint8_t scheme, uint32_t cycles);
+
+/**
+ * @brief Prints min, average, p99 and max cycles for every section and scheme
+ * with samples, as CSV.
+ * @param out Where to print, usually Serial.
+ */
+void printProfile(Print& out);
+
+/**
+ * @brief Clears all samples.
+ */
+void resetProfile();
+
+#ifdef WORDCLOCK_PROFILE
+// Times the rest of the enclosing block.
+class ProfileScope {
+public:
+    ProfileScope(ProfileSection section, uint8_t scheme)
+        : section(section), scheme(scheme), start(ESP.getCycleCount()) {}
+    ~ProfileScope() { profileRecord(section, scheme, ESP.getCycleCount() - start); }
+
+private:
+    ProfileSection section;
+    uint8_t scheme;
+    uint32_t start;
+};
+
+#define PROFILE_SCOPE(section, scheme) ProfileScope profileScope_(section, scheme)
+#else
+#define PROFILE_SCOPE(section, scheme) do {} while (0)
+#endif
+
+#endif // PROFILER_H
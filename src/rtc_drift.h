@@ -0,0 +1,97 @@
+/**
+ * @file rtc_drift.h
+ * @brief Drift estimation for the DS3231 from successive NTP syncs.
+ *
+ * At each NTP sync the RTC's offset from true time is divided by the time
+ * since the RTC was last set, giving its frequency error in ppm. The error
+ * the crystal would have with no aging offset is averaged over syncs and
+ * turned into a new aging offset, and the NTP interval grows while the
+ * remaining drift stays under target.
+ *
+ * Pure arithmetic with no hardware access, so it builds on any host.
+ */
+#ifndef RTC_DRIFT_H
+#define RTC_DRIFT_H
+
+#include <stdint.h>
+
+// Frequency change per LSB of the DS3231 aging offset register at 25°C.
+// A positive offset slows the oscillator.
+#define AGING_PPM_PER_LSB 0.1f
+
+// Samples averaged into the estimate; later samples get weight 1/DRIFT_AVERAGE_SAMPLES.
+#define DRIFT_AVERAGE_SAMPLES 4
+
+// Stored in NVS between boots.
+struct DriftEstimate {
+    float crystalPpm;  // Frequency error with an aging offset of 0, positive = RTC runs fast
+    uint8_t samples;   // Number of syncs the estimate is based on
+};
+
+/**
+ * @brief Frequency error measured over one interval.
+ * @param offsetMs RTC time minus true time at the end of the interval.
+ * @param elapsedS Length of the interval; the RTC was exact at its start.
+ * @return Error in ppm, positive if the RTC runs fast.
+ */
+inline float measuredPpm(int32_t offsetMs, uint32_t elapsedS) {
+    // 1 ppm is 1 ms per 1000 s
+    return elapsedS ? offsetMs * 1000.0f / elapsedS : 0.0f;
+}
+
+/**
+ * @brief Adds one interval's measurement to the estimate.
+ * @param estimate The estimate to update.
+ * @param residualPpm Error measured over the interval, see measuredPpm().
+ * @param agingOffset Aging offset that was programmed during the interval.
+ */
+inline void addDriftSample(DriftEstimate& estimate, float residualPpm, int8_t agingOffset) {
+    float crystalPpm = residualPpm + agingOffset * AGING_PPM_PER_LSB;
+    if (estimate.samples < DRIFT_AVERAGE_SAMPLES) {
+        estimate.samples++;
+    }
+    // Running mean for the first samples, then an exponential average
+    estimate.crystalPpm += (crystalPpm - estimate.crystalPpm) / estimate.samples;
+}
+
+/**
+ * @brief Aging offset that cancels the estimated crystal error.
+ */
+inline int8_t agingOffsetFor(const DriftEstimate& estimate) {
+    float lsb = estimate.crystalPpm / AGING_PPM_PER_LSB;
+    if (lsb >= 127.0f) {
+        return 127;
+    }
+    if (lsb <= -128.0f) {
+        return -128;
+    }
+    return (int8_t)(lsb < 0 ? lsb - 0.5f : lsb + 0.5f);
+}
+
+/**
+ * @brief Works out the next NTP sync interval.
+ *
+ * The interval is the time the measured drift takes to reach the target, but
+ * grows at most twofold per sync so one lucky measurement cannot push it out.
+ * @param currentS The interval in use, in seconds.
+ * @param residualPpm Error measured over the last interval.
+ * @param targetMs Largest acceptable RTC error at the end of an interval.
+ * @param minS Shortest allowed interval, in seconds.
+ * @param maxS Longest allowed interval, in seconds.
+ */
+inline uint32_t nextSyncInterval(uint32_t currentS, float residualPpm, uint32_t targetMs,
+                                 uint32_t minS, uint32_t maxS) {
+    float ppm = residualPpm < 0 ? -residualPpm : residualPpm;
+    float reachS = ppm > 0.0f ? targetMs * 1000.0f / ppm : (float)maxS;
+    float limitS = 2.0f * currentS;
+    float nextS = reachS < limitS ? reachS : limitS;
+    if (nextS < minS) {
+        return minS;
+    }
+    if (nextS > maxS) {
+        return maxS;
+    }
+    return (uint32_t)nextS;
+}
+
+#endif // RTC_DRIFT_H
@@ -0,0 +1,271 @@
+/**
+ * @file rtc_time.cpp
+ * @brief Restores system time and timezone at boot, before WiFi is up.
+ */
+
+#include "rtc_time.h"
+#include "rtc_drift.h"
+#include "tasks/clock_task.h"
+#include <Wire.h>
+#include <esp_sntp.h>
+#include <sys/time.h>
+#include <stdlib.h> // Required for setenv
+
+// --- DS3231 Registers ---
+#define DS3231_ADDRESS      0x68
+#define DS3231_REG_CONTROL  0x0E
+#define DS3231_REG_STATUS   0x0F
+#define DS3231_REG_AGING    0x10
+#define DS3231_CONTROL_CONV 0x20 // Start a temperature conversion
+#define DS3231_STATUS_BSY   0x04 // Conversion in progress
+
+static bool readRegister(uint8_t reg, uint8_t &value)
+{
+    Wire.beginTransmission(DS3231_ADDRESS);
+    Wire.write(reg);
+    if (Wire.endTransmission() != 0 || Wire.requestFrom((uint8_t)DS3231_ADDRESS, (uint8_t)1) != 1)
+    {
+        return false;
+    }
+    value = Wire.read();
+    return true;
+}
+
+static bool writeRegister(uint8_t reg, uint8_t value)
+{
+    Wire.beginTransmission(DS3231_ADDRESS);
+    Wire.write(reg);
+    Wire.write(value);
+    return Wire.endTransmission() == 0;
+}
+
+static int8_t readAgingOffset()
+{
+    uint8_t value = 0;
+    readRegister(DS3231_REG_AGING, value);
+    return (int8_t)value;
+}
+
+static void writeAgingOffset(int8_t offset)
+{
+    if (!writeRegister(DS3231_REG_AGING, (uint8_t)offset))
+    {
+        Serial.println("[RTC] Failed to write the aging offset.");
+        return;
+    }
+    // The new offset only takes effect at the next temperature conversion;
+    // start one now unless one is already running.
+    uint8_t status, control;
+    if (readRegister(DS3231_REG_STATUS, status) && !(status & DS3231_STATUS_BSY) &&
+        readRegister(DS3231_REG_CONTROL, control))
+    {
+        writeRegister(DS3231_REG_CONTROL, control | DS3231_CONTROL_CONV);
+    }
+}
+
+static bool loadDriftEstimate(AppContext *context, DriftEstimate &estimate)
+{
+    return context->preferences.getBytes(NVS_DRIFT_KEY, &estimate, sizeof(estimate)) == sizeof(estimate);
+}
+
+/**
+ * @brief Waits for the RTC's seconds to tick over, to within about 1 ms.
+ *
+ * The DS3231 only reports whole seconds; the instant its seconds change is
+ * the only time its full time is known. Takes up to 1 s.
+ * @param context Pointer to the shared application context.
+ * @param rtcnow Receives the RTC time read just after the tick.
+ * @return false if the RTC did not tick.
+ */
+static bool waitForRtcTick(AppContext *context, DateTime &rtcnow)
+{
+    uint8_t firstSecond = context->rtc.now().second();
+    uint32_t start = millis();
+    while (millis() - start < 1100)
+    {
+        rtcnow = context->rtc.now();
+        if (rtcnow.second() != firstSecond)
+        {
+            return true;
+        }
+        vTaskDelay(1);
+    }
+    return false;
+}
+
+/**
+ * @brief Measures RTC time minus system time with millisecond resolution.
+ *
+ * Compares the instant the RTC's seconds tick over with the system time.
+ * Takes up to 1 s.
+ * @param context Pointer to the shared application context.
+ * @param offsetMs Receives the offset, positive if the RTC is ahead.
+ * @return false if the RTC did not tick.
+ */
+static bool measureRtcOffset(AppContext *context, int32_t &offsetMs)
+{
+    DateTime rtcnow;
+    if (!waitForRtcTick(context, rtcnow))
+    {
+        return false;
+    }
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    int64_t rtcMs = (int64_t)rtcnow.unixtime() * 1000;
+    int64_t systemMs = (int64_t)tv.tv_sec * 1000 + tv.tv_usec / 1000;
+    offsetMs = (int32_t)(rtcMs - systemMs);
+    return true;
+}
+
+// Sets the RTC on a whole second of the system time. Writing the seconds
+// register restarts the DS3231's 1 Hz countdown, so the RTC is then in phase.
+static void setRtcOnSecond(AppContext *context)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    vTaskDelay(pdMS_TO_TICKS((1000000 - tv.tv_usec) / 1000));
+    context->rtc.adjust(DateTime((uint32_t)(tv.tv_sec + 1)));
+}
+
+bool initializeFromRtc(AppContext *context)
+{
+    if (!context->rtc.begin())
+    {
+        Serial.println("[ERROR] Couldn't find RTC! Clock will not keep time without power.");
+        return false;
+    }
+
+    if (context->rtc.lostPower())
+    {
+        Serial.println("[WARN] RTC lost power. Setting to compile time as fallback.");
+        context->rtc.adjust(DateTime(F(__DATE__), F(__TIME__)));
+        // The time it was last set from NTP no longer says anything about drift
+        context->preferences.remove(NVS_RTC_SET_KEY);
+    }
+
+    // The aging offset does not survive a power loss; put the learned one back
+    DriftEstimate estimate;
+    if (loadDriftEstimate(context, estimate) && readAgingOffset() != agingOffsetFor(estimate))
+    {
+        writeAgingOffset(agingOffsetFor(estimate));
+    }
+
+    DateTime rtcnow = context->rtc.now();
+    if (rtcnow.year() < 2024)
+    {
+        Serial.printf("[WARN] RTC has an invalid time (Year: %d). Waiting for WiFi sync.\n", rtcnow.year());
+        return false;
+    }
+
+    // Whole seconds only, so up to a second behind the RTC until
+    // alignSystemClockToRtc() puts it in phase on the next tick
+    struct timeval tv = {.tv_sec = static_cast<time_t>(rtcnow.unixtime()), .tv_usec = 0};
+    settimeofday(&tv, NULL);
+    Serial.println("System time initialized from hardware RTC.");
+
+    SystemCommand cmd = {SystemCommandType::START_CLOCK_DISPLAY};
+    sendSystemCommand(context, cmd);
+    return true;
+}
+
+bool restoreTimezone(AppContext *context)
+{
+    String tz_string = context->preferences.getString(NVS_TZ_KEY, "");
+    if (tz_string.length() == 0)
+    {
+        Serial.println("Timezone not yet known, defaulting to UTC for now.");
+        return false;
+    }
+    strncpy(context->time_zone, tz_string.c_str(), sizeof(context->time_zone) - 1);
+    setenv("TZ", tz_string.c_str(), 1);
+    tzset();
+    context->tz_generation++;
+    Serial.printf("Timezone set from NVS: %s\n", context->time_zone);
+    return true;
+}
+
+void calibrateRtcFromNtp(AppContext *context)
+{
+    time_t now_utc;
+    time(&now_utc);
+    uint32_t lastSet = context->preferences.getUInt(NVS_RTC_SET_KEY, 0);
+    uint32_t elapsed = (lastSet && now_utc > (time_t)lastSet) ? now_utc - lastSet : 0;
+    int32_t offsetMs = 0;
+    bool measured = lastSet && measureRtcOffset(context, offsetMs);
+
+    if (measured)
+    {
+        Serial.printf("[RTC] Offset from NTP: %d ms after %u s.\n", offsetMs, elapsed);
+    }
+    if (measured && elapsed < RTC_DRIFT_MIN_SAMPLE_S && abs(offsetMs) < RTC_DRIFT_TARGET_MS)
+    {
+        // Leave the RTC alone so the drift can build up to something measurable
+        return;
+    }
+
+    if (measured && elapsed >= RTC_DRIFT_MIN_SAMPLE_S)
+    {
+        DriftEstimate estimate = {0.0f, 0};
+        loadDriftEstimate(context, estimate);
+        int8_t aging = readAgingOffset();
+        float residual = measuredPpm(offsetMs, elapsed);
+        addDriftSample(estimate, residual, aging);
+        context->preferences.putBytes(NVS_DRIFT_KEY, &estimate, sizeof(estimate));
+
+        int8_t newAging = agingOffsetFor(estimate);
+        if (newAging != aging)
+        {
+            writeAgingOffset(newAging);
+        }
+
+        uint32_t interval = context->preferences.getUInt(NVS_SNTP_INTERVAL_KEY, SNTP_MIN_INTERVAL_S);
+        interval = nextSyncInterval(interval, residual, RTC_DRIFT_TARGET_MS, SNTP_MIN_INTERVAL_S, SNTP_MAX_INTERVAL_S);
+        context->preferences.putUInt(NVS_SNTP_INTERVAL_KEY, interval);
+        sntp_set_sync_interval(interval * 1000);
+        Serial.printf("[RTC] Drift %.2f ppm, crystal %.2f ppm over %u syncs, aging offset %d -> %d, next sync in %u s.\n",
+                      residual, estimate.crystalPpm, estimate.samples, aging, newAging, interval);
+    }
+
+    setRtcOnSecond(context);
+    time(&now_utc);
+    context->preferences.putUInt(NVS_RTC_SET_KEY, (uint32_t)now_utc);
+    Serial.println("[Time Sync] RTC has been updated with correct UTC time.");
+}
+
+void alignSystemClockToRtc(AppContext *context)
+{
+    int32_t offsetMs = 0;
+    if (!measureRtcOffset(context, offsetMs))
+    {
+        Serial.println("[RTC] No seconds tick, system clock left alone.");
+        return;
+    }
+    if (abs(offsetMs) < RTC_CLOCK_CHECK_MIN_MS)
+    {
+        return;
+    }
+
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    int64_t us = (int64_t)tv.tv_sec * 1000000 + tv.tv_usec + (int64_t)offsetMs * 1000;
+    tv.tv_sec = us / 1000000;
+    tv.tv_usec = us % 1000000;
+    settimeofday(&tv, NULL);
+    Serial.printf("[RTC] System clock was %d ms behind the RTC, stepped.\n", offsetMs);
+}
+
+void syncSystemClockToRtc(AppContext *context)
+{
+    // Before its first NTP set the RTC may hold anything, e.g. the compile time
+    if (!context->preferences.isKey(NVS_RTC_SET_KEY))
+    {
+        return;
+    }
+    alignSystemClockToRtc(context);
+}
+
+void applySyncInterval(AppContext *context)
+{
+    uint32_t interval = context->preferences.getUInt(NVS_SNTP_INTERVAL_KEY, SNTP_MIN_INTERVAL_S);
+    sntp_set_sync_interval(interval * 1000);
+}
@@ -0,0 +1,68 @@
+/**
+ * @file rtc_time.h
+ * @brief Restores system time from the DS3231 and the timezone from NVS.
+ *
+ * Runs in setup() before any task needs the time, so the clock can show the
+ * right time as soon as the LEDs are up, long before WiFi connects.
+ */
+#ifndef RTC_TIME_H
+#define RTC_TIME_H
+
+#include "AppContext.h"
+
+/**
+ * @brief Sets TZ from the timezone cached in NVS, if there is one.
+ * @param context Pointer to the shared application context.
+ * @return true if a cached timezone was found.
+ */
+bool restoreTimezone(AppContext *context);
+
+/**
+ * @brief Sets the system time from the RTC and starts the clock display if
+ * the RTC time is plausible. Returns at once; the system time is set to the
+ * RTC's whole second, see alignSystemClockToRtc().
+ * @param context Pointer to the shared application context.
+ * @return true if the system time was set.
+ */
+bool initializeFromRtc(AppContext *context);
+
+/**
+ * @brief Steps the system clock onto the RTC's next second edge.
+ *
+ * The DS3231 only reports whole seconds, so initializeFromRtc() leaves the
+ * system clock up to 1 s behind it. Call once the clock is showing the time;
+ * takes up to 1 s.
+ * @param context Pointer to the shared application context.
+ */
+void alignSystemClockToRtc(AppContext *context);
+
+/**
+ * @brief Sets the RTC from freshly synced system time, learning its drift.
+ *
+ * Measures how far the RTC drifted since it was last set and feeds that into
+ * the drift estimate in NVS. It then programs the DS3231 aging offset from
+ * the estimate and lengthens or shortens the NTP sync interval. If the last
+ * set was too recent to learn from and the RTC is still close, it is left
+ * alone so the drift can build up. Can take up to 2 s.
+ * @param context Pointer to the shared application context.
+ */
+void calibrateRtcFromNtp(AppContext *context);
+
+/**
+ * @brief Steps the system clock onto the RTC's second edge if it wandered off.
+ *
+ * The NTP interval is chosen for the drift of the calibrated DS3231, while the
+ * system clock runs on the ESP32 crystal. Calling this between syncs keeps the
+ * system clock, and so the display, as close to true time as the RTC. Does
+ * nothing until the RTC has been set from NTP once. Takes up to 1 s.
+ * @param context Pointer to the shared application context.
+ */
+void syncSystemClockToRtc(AppContext *context);
+
+/**
+ * @brief Applies the learned NTP sync interval. Call before starting SNTP.
+ * @param context Pointer to the shared application context.
+ */
+void applySyncInterval(AppContext *context);
+
+#endif // RTC_TIME_H
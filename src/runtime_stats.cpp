@@ -0,0 +1,27 @@
+/**
+ * @file runtime_stats.cpp
+ * @brief Serial output of runtime timing statistics.
+ */
+
+#include "runtime_stats.h"
+
+void printTimingStatsHeader(Print& out) {
+    out.println("stat,count,min_us,avg_us,max_us");
+}
+
+void printTimingStats(const char* name, const TimingStats& stats, Print& out) {
+    out.printf("%s,%u,%u,%u,%u\n", name, stats.count, stats.count ? stats.min_us : 0,
+               stats.average(), stats.max_us);
+}
+
+void printLatencyHistogramHeader(Print& out) {
+    out.println("histogram,attempts,failures,lt250ms,lt500ms,lt1s,lt2s,lt4s,lt8s,lt16s,ge16s");
+}
+
+void printLatencyHistogram(const char* name, const LatencyHistogram& histogram, Print& out) {
+    out.printf("%s,%u,%u", name, histogram.attempts, histogram.failures);
+    for (uint32_t count : histogram.buckets) {
+        out.printf(",%u", count);
+    }
+    out.println();
+}
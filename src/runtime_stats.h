@@ -0,0 +1,89 @@
+/**
+ * @file runtime_stats.h
+ * @brief Running timing statistics for measuring scheduling on the device.
+ *
+ * Each TimingStats is written by a single task; other tasks only read it for
+ * debug output, so a torn read shows up as one odd line, never a crash.
+ */
+#ifndef RUNTIME_STATS_H
+#define RUNTIME_STATS_H
+
+#include <Arduino.h>
+
+// Count, min, max and total of a series of durations in microseconds.
+struct TimingStats {
+    uint32_t count = 0;
+    uint32_t min_us = UINT32_MAX;
+    uint32_t max_us = 0;
+    uint64_t total_us = 0;
+
+    void record(uint32_t us) {
+        count++;
+        total_us += us;
+        if (us < min_us) {
+            min_us = us;
+        }
+        if (us > max_us) {
+            max_us = us;
+        }
+    }
+
+    uint32_t average() const { return count ? total_us / count : 0; }
+
+    void reset() { *this = TimingStats(); }
+};
+
+#define LATENCY_BUCKETS    8
+#define LATENCY_BUCKET0_MS 250 // Upper bound of the first bucket; each next one doubles
+
+// Attempts of a slow operation, such as a network request, by duration in ms.
+// Buckets: <250ms, <500ms, <1s, <2s, <4s, <8s, <16s, 16s and more.
+struct LatencyHistogram {
+    uint32_t attempts = 0;
+    uint32_t failures = 0;
+    uint32_t buckets[LATENCY_BUCKETS] = {};
+
+    void record(uint32_t ms, bool ok) {
+        uint8_t bucket = 0;
+        for (uint32_t limit = LATENCY_BUCKET0_MS; ms >= limit && bucket < LATENCY_BUCKETS - 1; limit <<= 1) {
+            bucket++;
+        }
+        buckets[bucket]++;
+        attempts++;
+        if (!ok) {
+            failures++;
+        }
+    }
+
+    void reset() { *this = LatencyHistogram(); }
+};
+
+/**
+ * @brief Prints the column names that printTimingStats() fills in.
+ * @param out Where to print, usually Serial.
+ */
+void printTimingStatsHeader(Print& out);
+
+/**
+ * @brief Prints one TimingStats as a CSV row.
+ * @param name Row label.
+ * @param stats The statistics to print.
+ * @param out Where to print, usually Serial.
+ */
+void printTimingStats(const char* name, const TimingStats& stats, Print& out);
+
+/**
+ * @brief Prints the column names that printLatencyHistogram() fills in.
+ * @param out Where to print, usually Serial.
+ */
+void printLatencyHistogramHeader(Print& out);
+
+/**
+ * @brief Prints one LatencyHistogram as a CSV row.
+ * @param name Row label.
+ * @param histogram The histogram to print.
+ * @param out Where to print, usually Serial.
+ */
+void printLatencyHistogram(const char* name, const LatencyHistogram& histogram, Print& out);
+
+#endif // RUNTIME_STATS_H
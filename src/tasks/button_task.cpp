@@ -9,6 +9,7 @@
 
 #include "button_task.h"
 #include "../AppContext.h"
+#include "clock_task.h"
 #include "../config.h"
 
 // FSM for button debouncing and long press detection
@@ -67,7 +68,7 @@ void taskButtonCheck(void *pvParameters) {
         if (b1_fsm == ButtonFSM::RELEASED) {
             SystemCommand cmd;
             cmd.type = b1_long ? SystemCommandType::PREV_COLOR_SCHEME : SystemCommandType::NEXT_COLOR_SCHEME;
-            xQueueSend(context->systemCommandQueue, &cmd, 0);
+            sendSystemCommand(context, cmd);
             b1_fsm = ButtonFSM::IDLE; // Reset FSM after handling
         }
 
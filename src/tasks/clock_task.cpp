@@ -3,83 +3,312 @@
  * @brief Implements the FreeRTOS task for updating the clock display.
  *
  * This task is the main display loop. It waits for commands to change display
- * modes (like color schemes or animations) and continuously updates the
- * time on the LED matrix. It accesses all hardware and state via the AppContext.
+ * modes (like color schemes or animations) and updates the time on the LED
+ * matrix, waking only as often as the current scheme or animation needs.
+ * It accesses all hardware and state via the AppContext.
  */
 
 #include "clock_task.h"
 #include "../AppContext.h"
 #include "../time_display.h"
 #include "../animations.h"
+#include "../color_schemes.h"
+#include "../frame_debug.h"
+#include "../runtime_stats.h"
+#include "../profiler.h"
+#include "../local_time.h"
 #include <TimeLib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/**
+ * @brief Sends the LED buffer to the strip, unless it matches the last frame sent.
+ *
+ * Static schemes and settled fades produce the same frame over and over; there is
+ * no point clocking identical data out over RMT at 50Hz.
+ * @param context Pointer to the shared application context.
+ * @return true if the frame was sent.
+ */
+static bool showIfChanged(AppContext* context) {
+    static CRGB lastShown[NUM_LEDS];
+    static bool anyShown = false;
+
+    context->frames_rendered++;
+    if (anyShown && memcmp(lastShown, context->leds, sizeof(lastShown)) == 0) {
+        return false;
+    }
+    memcpy(lastShown, context->leds, sizeof(lastShown));
+    {
+        PROFILE_SCOPE(PROFILE_LED_SHOW, context->colorSchemeIndex);
+        FastLED.show();
+    }
+
+    static uint32_t lastPushUs = 0;
+    uint32_t nowUs = micros();
+    if (anyShown) {
+        context->frame_interval.record(nowUs - lastPushUs);
+    }
+    lastPushUs = nowUs;
+    anyShown = true;
+    context->frames_pushed++;
+    return true;
+}
 
 /**
  * @brief Handles incoming commands from the system command queue.
+ *
+ * Commands that show an animation only start it on the animation stack;
+ * the animation itself is played frame by frame from the main loop.
  * @param context Pointer to the shared application context.
+ * @param animations The clock task's active animations.
  * @param cmd The command to be processed.
  */
-static void handleCommand(AppContext* context, const SystemCommand& cmd) {
-    uint8_t baseHue = (millis() / 60) % 256;
+static void handleCommand(AppContext* context, AnimationStack& animations, const SystemCommand& cmd) {
+    context->command_latency.record(micros() - cmd.sent_us);
+    uint32_t now = millis();
+    uint8_t baseHue = (now / 60) % 256;
     switch (cmd.type) {
         case SystemCommandType::NEXT_COLOR_SCHEME:
-            context->colorSchemeIndex = (context->colorSchemeIndex + 1) % NUM_COLOR_SCHEMES;
-            indicateNumber(context->leds, context->colorSchemeIndex + 1, CHSV(baseHue, 255, 255));
+            context->colorSchemeIndex = (context->colorSchemeIndex + 1) % colorSchemeCount();
+            animations.start(indicateNumberAnimation(context->colorSchemeIndex + 1, CHSV(baseHue, 255, 255), now));
             break;
         case SystemCommandType::PREV_COLOR_SCHEME:
             context->colorSchemeIndex--;
             if (context->colorSchemeIndex < 0) {
-                context->colorSchemeIndex = NUM_COLOR_SCHEMES - 1;
+                context->colorSchemeIndex = colorSchemeCount() - 1;
             }
-            indicateNumber(context->leds, context->colorSchemeIndex + 1, CHSV(baseHue, 255, 255));
+            animations.start(indicateNumberAnimation(context->colorSchemeIndex + 1, CHSV(baseHue, 255, 255), now));
             break;
         case SystemCommandType::SHOW_WIFI_ANIMATION:
-            wifiConnectAnimation(context->leds);
+            animations.start(wifiConnectAnimation(now));
             break;
-        case SystemCommandType::START_CLOCK_DISPLAY:
+        case SystemCommandType::START_CLOCK_DISPLAY: {
             context->time_is_valid = true;
-            // Add a delay to show connection success before showing time
-            vTaskDelay(pdMS_TO_TICKS(2000));
+            xEventGroupSetBits(context->bootEvents, BOOT_TIME_VALID);
+            markBootPhase(context->boot_profile, BOOT_PHASE_TIME_VALID);
+            // Hold the current frame to show connection success before showing time,
+            // unless an animation is already playing in front of the clock. With
+            // nothing on the LEDs (time from the RTC at boot) show the time at once.
+            bool anyLit = false;
+            for (const CRGB& led : context->leds) {
+                anyLit |= (bool)led;
+            }
+            if (anyLit && !animations.active()) {
+                animations.push(holdAnimation(2000, now));
+            }
             break;
+        }
+        case SystemCommandType::DUMP_FRAME:
+            printFrameAscii(context->leds, Serial);
+            break;
+        case SystemCommandType::DUMP_FRAME_PPM:
+            printFramePpm(context->leds, Serial);
+            break;
+        case SystemCommandType::BENCHMARK_SCHEMES:
+            benchmarkColorSchemes(Serial);
+            break;
+        case SystemCommandType::BENCHMARK_DAY:
+            benchmarkDay(Serial);
+            break;
+        case SystemCommandType::PRINT_STATS:
+            printTimingStatsHeader(Serial);
+            printTimingStats("command_latency", context->command_latency, Serial);
+            printTimingStats("frame_render", context->frame_render, Serial);
+            printTimingStats("frame_interval", context->frame_interval, Serial);
+            printTimingStats("epd_refresh", context->epd_refresh, Serial);
+            printTimingStats("minute_latency", context->minute_latency, Serial);
+            Serial.println("counter,value");
+            Serial.printf("epd_refresh_requests,%u\n", context->epd_refreshes.requests);
+            Serial.printf("epd_full_refreshes,%u\n", context->epd_refreshes.full);
+            Serial.printf("epd_partial_refreshes,%u\n", context->epd_refreshes.partial);
+            Serial.printf("epd_suppressed_refreshes,%u\n", context->epd_refreshes.suppressed);
+            Serial.printf("epd_busy_timeouts,%u\n", context->display.busyTimeouts());
+            Serial.printf("epd_active_ms,%u\n", context->epd_active_ms);
+            // Scaled up from the uptime so far
+            Serial.printf("epd_active_ms_per_day,%u\n",
+                          (uint32_t)((uint64_t)context->epd_active_ms * 86400000 / (millis() + 1)));
+            printLatencyHistogramHeader(Serial);
+            printLatencyHistogram("sync_timezone", context->sync_timezone, Serial);
+            printLatencyHistogram("sync_ntp", context->sync_ntp, Serial);
+            break;
+        case SystemCommandType::RESET_STATS:
+            context->command_latency.reset();
+            context->frame_render.reset();
+            context->frame_interval.reset();
+            context->epd_refresh.reset();
+            context->minute_latency.reset();
+            context->sync_timezone.reset();
+            context->sync_ntp.reset();
+            resetProfile();
+            break;
+        case SystemCommandType::PRINT_PROFILE:
+            printProfile(Serial);
+            break;
+        case SystemCommandType::PRINT_BOOT_PROFILE:
+            printBootProfile(context->boot_profile, Serial);
+            break;
+        case SystemCommandType::EPD_FULL_REFRESH: {
+            // No new frame: the EPD task refreshes the panel with what it shows
+            EpdUpdate update = {0, 0, 0, 0, true, false};
+            xQueueSend(context->epdQueue, &update, 0);
+            break;
+        }
     }
 }
 
+/**
+ * @brief Works out how long the clock task can sleep before the next frame.
+ * @param context Pointer to the shared application context.
+ * @param busy True while an animation or crossfade is playing.
+ * @param frameChanged True if the last frame differed from the one before.
+ * @return Time to wait for a command before drawing the next frame.
+ */
+static TickType_t nextFrameTimeout(AppContext* context, bool busy, bool frameChanged) {
+    if (busy) {
+        return pdMS_TO_TICKS(FRAME_INTERVAL_MS);
+    }
+    if (!context->time_is_valid) {
+        // Fading to black; once dark, nothing changes until a command arrives.
+        return frameChanged ? pdMS_TO_TICKS(FRAME_INTERVAL_MS) : portMAX_DELAY;
+    }
+    switch (colorScheme(context->colorSchemeIndex).refresh) {
+        case REFRESH_STATIC: {
+            // Sleep until just after the next minute boundary. With RTC_SQW_PIN
+            // the RTC tick wakes the task every second well before that; the
+            // timeout only matters if the square wave stops.
+            struct timeval tv;
+            gettimeofday(&tv, NULL);
+            uint32_t msIntoMinute = (tv.tv_sec % 60) * 1000 + tv.tv_usec / 1000;
+            return pdMS_TO_TICKS(60000 - msIntoMinute + 5);
+        }
+        case REFRESH_LOW:
+            return pdMS_TO_TICKS(LOW_REFRESH_INTERVAL_MS);
+        case REFRESH_FULL:
+        default:
+            return pdMS_TO_TICKS(FRAME_INTERVAL_MS);
+    }
+}
+
+// Largest lag of the system clock behind an RTC second edge that is rounded away.
+#define RTC_EDGE_WINDOW_US 20000
+
+/**
+ * @brief Returns the current UTC time in whole seconds.
+ *
+ * With the RTC tick the task wakes on the RTC's second edge, which the system
+ * clock can trail by a few ms. Right after an edge the time is rounded up, so
+ * that lag does not show the old second; other frames use the plain time.
+ * @param context Pointer to the shared application context.
+ */
+static time_t currentUtc([[maybe_unused]] AppContext* context) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+#ifdef RTC_SQW_PIN
+    bool onEdge = micros() - context->rtc_edge_us < RTC_EDGE_WINDOW_US;
+    if (onEdge && tv.tv_usec >= 1000000 - RTC_EDGE_WINDOW_US) {
+        return tv.tv_sec + 1;
+    }
+#endif
+    return tv.tv_sec;
+}
+
+/**
+ * @brief Returns how long ago the current minute started, in microseconds.
+ * @param context Pointer to the shared application context.
+ */
+static uint32_t minuteLatencyUs([[maybe_unused]] AppContext* context) {
+#ifdef RTC_SQW_PIN
+    // The minute started on the RTC edge that woke the task, unless the
+    // fallback timeout woke it instead
+    uint32_t sinceEdge = micros() - context->rtc_edge_us;
+    if (sinceEdge < 1000000) {
+        return sinceEdge;
+    }
+#endif
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (tv.tv_sec % 60) * 1000000 + tv.tv_usec;
+}
+
+bool sendSystemCommand(AppContext* context, const SystemCommand& cmd) {
+    if (xQueueSend(context->systemCommandQueue, &cmd, 0) != pdPASS) {
+        return false;
+    }
+    if (context->clockTask) {
+        xTaskNotifyGive(context->clockTask);
+    }
+    return true;
+}
+
 void taskClockUpdate(void *pvParameters) {
     Serial.println("Clock Task started.");
     auto* context = static_cast<AppContext*>(pvParameters);
     SystemCommand receivedCommand;
+    AnimationStack animations;
+    MaskTransition transition;
+    LocalTimeCache localTime;
+    TickType_t timeout = 0;
     bool first_run = true;
+    int32_t shownMinute = -1; // Minute of the day on the LEDs, to time minute changes
 
     for (;;) {
-        // 1. Check for incoming commands without blocking.
-        if (xQueueReceive(context->systemCommandQueue, &receivedCommand, 0) == pdPASS) {
-            handleCommand(context, receivedCommand);
+        // 1. Sleep until a command or the RTC tick wakes the task or the next frame is due,
+        //    then drain the queue. A tick only wakes the task; the frame is drawn below.
+        ulTaskNotifyTake(pdTRUE, timeout);
+        while (xQueueReceive(context->systemCommandQueue, &receivedCommand, 0) == pdPASS) {
+            handleCommand(context, animations, receivedCommand);
         }
+        context->clock_wakeups++;
 
         // 2. Update display based on current state
-        if (context->time_is_valid) {
-            time_t now_utc;
-            struct tm timeinfo_local;
-            time(&now_utc); // Get current system time (UTC epoch)
-            localtime_r(&now_utc, &timeinfo_local); // Convert to local time structure
+        uint32_t renderStart = micros();
+        uint32_t now = millis();
+        bool busy = false;
+        bool newMinute = false;
+        int32_t minute = shownMinute;
+        if (animations.tick(context->leds, now)) {
+            // An animation owns the display this frame; fade the time back in afterwards.
+            transition.clear();
+            busy = true;
+        } else if (context->time_is_valid) {
+            time_t now_utc = currentUtc(context);
+            // Convert to local time with the cached offset; TZ rules only run at transitions
+            uint32_t secondOfDay = localTime.secondOfDay(now_utc, context->tz_generation);
+            minute = secondOfDay / 60;
+            newMinute = minute != shownMinute;
 
             // One-time debug print to confirm time is being displayed
             if (first_run) {
+                struct tm timeinfo_local;
+                localtime_r(&now_utc, &timeinfo_local);
                 char time_buf[64];
                 strftime(time_buf, sizeof(time_buf), "%A, %B %d %Y %H:%M:%S %Z", &timeinfo_local);
                 Serial.printf("[Clock Task] First time displayed: %s\n", time_buf);
+                markBootPhase(context->boot_profile, BOOT_PHASE_FIRST_TIME_FRAME);
                 first_run = false;
             }
 
             // Update the display with the current time and color scheme
-            uint8_t baseHue = (millis() / 60) % 256; // Slowly cycle hue over time
-            writeTime(timeinfo_local.tm_hour, timeinfo_local.tm_min, context->leds, CHSV(baseHue, 255, 255), (ColorScheme)context->colorSchemeIndex);
-            
+            uint8_t baseHue = (now / 60) % 256; // Slowly cycle hue over time
+            PROFILE_SCOPE(PROFILE_WRITE_TIME, context->colorSchemeIndex);
+            writeTime(secondOfDay / 3600, (secondOfDay / 60) % 60, context->leds, CHSV(baseHue, 255, 255),
+                      context->colorSchemeIndex, transition, now);
+            busy = transition.active(now);
         } else {
             // If time is not valid yet, just keep the LEDs off.
             fadeToBlackBy(context->leds, NUM_LEDS, 10);
+            transition.clear();
         }
-        
-        FastLED.show();
-        vTaskDelay(pdMS_TO_TICKS(20)); // ~50Hz update rate
+
+        context->frame_render.record(micros() - renderStart);
+        bool frameChanged = showIfChanged(context);
+        if (newMinute) {
+            // The first minute after boot has no boundary to measure from
+            if (shownMinute >= 0) {
+                context->minute_latency.record(minuteLatencyUs(context));
+            }
+            shownMinute = minute;
+        }
+        timeout = nextFrameTimeout(context, busy, frameChanged);
     }
 }
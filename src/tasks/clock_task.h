@@ -8,6 +8,20 @@
 
 #include <Arduino.h>
 
+struct AppContext;
+struct SystemCommand;
+
+/**
+ * @brief Queues a command for the clock task and wakes it.
+ *
+ * The clock task sleeps on its task notification rather than on the queue,
+ * so the RTC tick can wake it without taking a queue slot.
+ * @param context Pointer to the shared application context.
+ * @param cmd The command.
+ * @return false if the queue was full and the command was dropped.
+ */
+bool sendSystemCommand(AppContext *context, const SystemCommand &cmd);
+
 /**
  * @brief The main function for the clock update task.
  * @param pvParameters A void pointer to the global AppContext struct.
@@ -0,0 +1,74 @@
+/**
+ * @file console_task.cpp
+ * @brief Implements a line-based debug console on the serial port.
+ *
+ * The console only parses commands. Anything that touches the LED frame or
+ * color scheme state is forwarded to the clock task, which owns them.
+ */
+
+#include "console_task.h"
+#include "../AppContext.h"
+#include "clock_task.h"
+
+#define CONSOLE_LINE_LENGTH 32
+#define CONSOLE_POLL_RATE_MS 50
+
+struct ConsoleCommand {
+    const char *name;
+    const char *help;
+    SystemCommandType command;
+};
+
+static const ConsoleCommand consoleCommands[] = {
+    {"frame", "Print the current LED frame as an ASCII grid", SystemCommandType::DUMP_FRAME},
+    {"ppm", "Print the current LED frame as a PPM image", SystemCommandType::DUMP_FRAME_PPM},
+    {"bench", "Benchmark every color scheme (pauses the display)", SystemCommandType::BENCHMARK_SCHEMES},
+    {"day", "Render and check every minute of a day per scheme", SystemCommandType::BENCHMARK_DAY},
+    {"stats", "Print queue latency, frame, e-paper and time sync timings", SystemCommandType::PRINT_STATS},
+    {"prof", "Print render cycle counts per scheme (WORDCLOCK_PROFILE builds)", SystemCommandType::PRINT_PROFILE},
+    {"boot", "Print when each boot phase was reached", SystemCommandType::PRINT_BOOT_PROFILE},
+    {"epd", "Fully refresh the e-paper display to clear ghosting", SystemCommandType::EPD_FULL_REFRESH},
+    {"reset", "Clear the timings printed by stats and prof", SystemCommandType::RESET_STATS},
+};
+
+/**
+ * @brief Runs a single console command line.
+ * @param context Pointer to the shared application context.
+ * @param line The command, without line ending.
+ */
+static void runCommand(AppContext *context, const char *line) {
+    for (const ConsoleCommand &c : consoleCommands) {
+        if (strcmp(line, c.name) == 0) {
+            SystemCommand cmd = {c.command};
+            sendSystemCommand(context, cmd);
+            return;
+        }
+    }
+    Serial.println("Commands:");
+    for (const ConsoleCommand &c : consoleCommands) {
+        Serial.printf("  %-8s %s\n", c.name, c.help);
+    }
+}
+
+void taskConsole(void *pvParameters) {
+    Serial.println("Console Task started.");
+    auto *context = static_cast<AppContext *>(pvParameters);
+    char line[CONSOLE_LINE_LENGTH];
+    size_t length = 0;
+
+    for (;;) {
+        while (Serial.available()) {
+            char c = Serial.read();
+            if (c == '\r' || c == '\n') {
+                if (length > 0) {
+                    line[length] = '\0';
+                    runCommand(context, line);
+                    length = 0;
+                }
+            } else if (length < sizeof(line) - 1) {
+                line[length++] = c;
+            }
+        }
+        vTaskDelay(pdMS_TO_TICKS(CONSOLE_POLL_RATE_MS));
+    }
+}
@@ -0,0 +1,17 @@
+/**
+ * @file console_task.h
+ * @brief Header for the Serial debug console FreeRTOS task.
+ */
+
+#ifndef CONSOLE_TASK_H
+#define CONSOLE_TASK_H
+
+#include <Arduino.h>
+
+/**
+ * @brief The main function for the serial console task.
+ * @param pvParameters A void pointer to the global AppContext struct.
+ */
+void taskConsole(void *pvParameters);
+
+#endif // CONSOLE_TASK_H
@@ -4,14 +4,19 @@
  *
  * This file contains two tasks:
  * 1. taskWiFi: An event-driven task that handles WiFi connection, provisioning,
- * and NTP time synchronization.
- * 2. task_epd: A simple task that waits for signals to update the E-Paper display.
+ * and NTP time synchronization. Time sync is a state machine stepped between
+ * network events, so it never keeps the task from reacting to them.
+ * 2. task_epd: Waits for frames drawn by taskWiFi and shows them on the E-Paper display,
+ * which it alone draws into.
  * Both tasks use the shared AppContext for resources.
  */
 
 #include "wifi_task.h"
 #include "../AppContext.h"
+#include "clock_task.h"
 #include "../certs.h"
+#include "../rtc_time.h"
+#include "../epd_refresh.h"
 #include <WiFiClientSecure.h>
 #include <WiFiProvisioner.h>
 #include <HTTPClient.h>
@@ -22,9 +27,44 @@
 #include <sys/time.h>
 #include "fonts/FreeSans9pt7b.h"
 
+// --- Time Sync State Machine ---
+// A sync fetches the timezone over HTTPS, then starts SNTP and waits for its
+// SNTP_SYNC event. With a timezone cached in NVS the order is reversed: NTP
+// runs first, so the right time is shown without waiting for a TLS handshake,
+// and the timezone is refreshed afterwards only if it is due. Failed attempts
+// are retried with backoff; in between, the task goes back to waiting on the
+// network event queue.
+enum class SyncState
+{
+    IDLE,
+    FETCH_TIMEZONE, // Next timezone fetch is due at nextStepAt
+    START_NTP,      // Next SNTP start is due at nextStepAt
+    WAIT_NTP,       // Waiting for SNTP_SYNC until nextStepAt
+};
+
+struct TimeSync
+{
+    SyncState state = SyncState::IDLE;
+    uint8_t attempt = 0;       // Failed attempts in the current phase
+    uint32_t nextStepAt = 0;   // millis() when stepSync() is next due
+    uint32_t attemptStart = 0; // millis() when the current SNTP attempt started
+    bool timezoneAfterNtp = false; // Timezone is cached; check for a refresh after NTP
+};
+
+// Any earlier UTC time means the clock has not been set (2024-01-01).
+#define MIN_VALID_EPOCH 1704067200
+
 // --- Helper Function Prototypes ---
-static bool initializeFromRtc(AppContext *context);
-static bool getTimezoneAndSync(AppContext *context);
+static bool timezoneRefreshDue(AppContext *context);
+static void markTimezoneFetched(AppContext *context);
+static bool fetchTimezone(AppContext *context);
+static void startSync(AppContext *context, TimeSync &sync);
+static void cancelSync(TimeSync &sync, const char *reason);
+static TickType_t syncTimeout(const TimeSync &sync);
+static TickType_t clockCheckTimeout(const TimeSync &sync, uint32_t lastCheck);
+static void stepSync(AppContext *context, TimeSync &sync);
+static void completeSync(AppContext *context, TimeSync &sync);
+static void showStatus(AppContext *context);
 static void blankDisplay(AppContext *context);
 
 void taskWiFi(void *pvParameters)
@@ -32,33 +72,40 @@ void taskWiFi(void *pvParameters)
     Serial.println("WiFi Task started.");
     auto *context = static_cast<AppContext *>(pvParameters);
 
-    // Attempt to initialize system time from the hardware RTC first.
-    // This provides an immediate time display while WiFi connects in the background.
-    initializeFromRtc(context);
-
     NetworkEvent_t rxevent;
+    TimeSync sync;
+    uint32_t lastClockCheck = millis();
     for (;;)
     {
-        // Block and wait for a network event to occur
-        if (xQueueReceive(context->networkEventQueue, &rxevent, portMAX_DELAY))
+        // Wait for a network event, until the next time sync step is due, or
+        // until the system clock is due to be checked against the RTC
+        TickType_t timeout = min(syncTimeout(sync), clockCheckTimeout(sync, lastClockCheck));
+        if (!xQueueReceive(context->networkEventQueue, &rxevent, timeout))
+        {
+            if (syncTimeout(sync) == 0)
+            {
+                stepSync(context, sync);
+            }
+            else if (clockCheckTimeout(sync, lastClockCheck) == 0)
+            {
+                syncSystemClockToRtc(context);
+                lastClockCheck = millis();
+            }
+        }
+        else
         {
             switch (rxevent)
             {
             case WIFI_EVENT_DISCONNECTED:
             {
                 Serial.println("[WiFi Task] Event: Disconnected. Attempting to reconnect...");
+                cancelSync(sync, "WiFi disconnected");
                 Serial.println("[WiFi Task] Could not connect. Starting provisioning portal.");
                 //context->display_offset_x = random(context->maxiumum_offset);
                 //context->display_offset_y = random(context->maxiumum_offset);
-                context->display.clearBuffer();
-                context->display.fillScreen(EPD_WHITE);
-                context->display.setCursor(context->display_offset_x, context->display_offset_y);
-                context->display.setTextSize(1);
-                context->display.setTextColor(EPD_BLACK);
-                context->display.println("Status: Disconnected");
-                //context->display.setTextColor(EPD_WHITE);
-                context->display.println("Attempting Re-Connect...");
-                xQueueSend(context->epdQueue, NULL, portMAX_DELAY);
+                context->status_screen.set(STATUS_STATE, "Disconnected, reconnecting...");
+                context->status_screen.set(STATUS_IP, "IP: -");
+                showStatus(context);
                 WiFi.begin();
             }
             break;
@@ -71,7 +118,7 @@ void taskWiFi(void *pvParameters)
                 if (WiFi.status() == WL_CONNECTED)
                 {
                     Serial.println("[WiFi Task] Already connected. Proceeding directly to time sync.");
-                    getTimezoneAndSync(context);
+                    startSync(context, sync);
                     break; // Exit the case
                 }
 
@@ -91,16 +138,10 @@ void taskWiFi(void *pvParameters)
                     Serial.println("[WiFi Task] Could not connect. Starting provisioning portal.");
                     //context->display_offset_x = random(context->maxiumum_offset);
                     //context->display_offset_y = random(context->maxiumum_offset);
-                    context->display.clearBuffer();
-                    context->display.fillScreen(EPD_WHITE);
-                    context->display.setCursor(context->display_offset_x, context->display_offset_y);
-                    context->display.setTextSize(1);
-                    context->display.setTextColor(EPD_BLACK);
-                    context->display.println("Status: Configure WiFi");
-                    //context->display.setTextColor(EPD_BLACK);
-                    context->display.printf("Connect to AP:\n%s\n", WIFI_PROV_SSID);
-                    context->display.println("and sign into the portal.");
-                    xQueueSend(context->epdQueue, NULL, portMAX_DELAY);
+                    context->status_screen.set(STATUS_STATE, "Status: Configure WiFi");
+                    context->status_screen.set(STATUS_SSID, "Connect to AP: %s", WIFI_PROV_SSID);
+                    context->status_screen.set(STATUS_IP, "and sign into the portal.");
+                    showStatus(context);
 
                     WiFiProvisioner::Config customCfg(
                         WIFI_PROV_SSID,                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                        // Access Point Name
@@ -134,42 +175,25 @@ void taskWiFi(void *pvParameters)
             case WIFI_EVENT_CONNECTED:
             {
                 Serial.printf("[WiFi Task] Event: Connected! IP: %s\n", WiFi.localIP().toString().c_str());
+                markBootPhase(context->boot_profile, BOOT_PHASE_WIFI_CONNECTED);
 
                 SystemCommand cmd = {SystemCommandType::SHOW_WIFI_ANIMATION};
-                xQueueSend(context->systemCommandQueue, &cmd, 0);
+                sendSystemCommand(context, cmd);
                 vTaskDelay(pdMS_TO_TICKS(100));
                 //context->display_offset_x = random(context->maxiumum_offset);
                 //context->display_offset_y = random(context->maxiumum_offset);
-                context->display.clearBuffer();
-                context->display.fillScreen(EPD_WHITE);
-                context->display.setCursor(context->display_offset_x, context->display_offset_y);
-                context->display.setTextSize(1);
-                context->display.setTextColor(EPD_BLACK);
-                context->display.println("WiFi Connected");
-                context->display.setTextColor(EPD_BLACK);
-                context->display.printf("SSID: ");
-                context->display.setTextColor(EPD_BLACK);
-                context->display.printf("%s\n", WiFi.SSID().c_str());
-                context->display.setTextColor(EPD_BLACK);
-                context->display.printf("IP: ");
-                context->display.setTextColor(EPD_BLACK);
-                context->display.printf("%s\n", WiFi.localIP().toString().c_str());
-                context->display.println("Syncing time...");
-                xQueueSend(context->epdQueue, NULL, portMAX_DELAY);
-
-                if (getTimezoneAndSync(context))
-                {
-                    Serial.println("[WiFi Task] Time sync successful.");
-                }
-                else
-                {
-                    Serial.println("[WiFi Task] Time sync failed after all retries.");
-                }
+                context->status_screen.set(STATUS_STATE, "WiFi Connected, syncing time...");
+                context->status_screen.set(STATUS_SSID, "SSID: %s", WiFi.SSID().c_str());
+                context->status_screen.set(STATUS_IP, "IP: %s", WiFi.localIP().toString().c_str());
+                showStatus(context);
+
+                startSync(context, sync);
             }
             break;
 
             case CLEAR_WIFI:
             {
+                cancelSync(sync, "clearing WiFi credentials");
                 WiFi.mode(WIFI_STA);
                 WiFi.begin();
                 Serial.println("[WiFi Task] Event: Clear WiFi credentials and reboot.");
@@ -181,38 +205,36 @@ void taskWiFi(void *pvParameters)
 
             case SNTP_SYNC:
             {
-                // update epd with full display refresh, resynchronize RTC
+                // update the status screen, resynchronize RTC
                 struct tm timeinfo;
 
-                //context->display_offset_x = random(context->maxiumum_offset);
-                //context->display_offset_y = random(context->maxiumum_offset);
-                context->display.clearBuffer();
-                context->display.fillScreen(EPD_WHITE);
-                xQueueSend(context->epdQueue, NULL, portMAX_DELAY);
-                context->display.setCursor(context->display_offset_x, context->display_offset_y);
-                context->display.setTextSize(1);
-                context->display.setTextColor(EPD_BLACK);
-                context->display.println("Status: WiFi Connected");
-                context->display.setTextColor(EPD_BLACK);
-                context->display.printf("SSID: ");
-                context->display.setTextColor(EPD_BLACK);
-                context->display.printf("%s\n", WiFi.SSID().c_str());
-                context->display.setTextColor(EPD_BLACK);
-                context->display.printf("IP: ");
-                context->display.setTextColor(EPD_BLACK);
-                context->display.printf("%s\n", WiFi.localIP().toString().c_str());
+                context->status_screen.set(STATUS_STATE, "Status: WiFi Connected");
+                context->status_screen.set(STATUS_SSID, "SSID: %s", WiFi.SSID().c_str());
+                context->status_screen.set(STATUS_IP, "IP: %s", WiFi.localIP().toString().c_str());
                 time_t now_utc;
+                calibrateRtcFromNtp(context);
                 time(&now_utc);
-                context->rtc.adjust(DateTime(now_utc));
-                Serial.println("[Time Sync] RTC has been updated with correct UTC time.");
                 setenv("TZ", context->time_zone, 1);
                 tzset();
+                context->tz_generation++;
                 char time_buf[64];
                 localtime_r(&now_utc, &timeinfo);
                 strftime(time_buf, sizeof(time_buf), "%b %d %H:%M:%S %Z", &timeinfo);
-                //context->display.println("Sync successful!");
-                context->display.printf("Sync: %s\n", time_buf);
-                xQueueSend(context->epdQueue, NULL, portMAX_DELAY);
+                context->status_screen.set(STATUS_SYNC, "Sync: %s", time_buf);
+                showStatus(context);
+
+                if (sync.state == SyncState::WAIT_NTP)
+                {
+                    completeSync(context, sync);
+                }
+
+                // SNTP can still deliver after a cancelled sync, so the first valid time
+                // starts the clock whatever state the sync is in
+                if (!(xEventGroupGetBits(context->bootEvents) & BOOT_TIME_VALID))
+                {
+                    SystemCommand cmd = {SystemCommandType::START_CLOCK_DISPLAY};
+                    sendSystemCommand(context, cmd);
+                }
             }
             break;
             }
@@ -225,199 +247,309 @@ void task_epd(void *pvParameters)
 {
     Serial.println("EPD Task started.");
     auto *context = static_cast<AppContext *>(pvParameters);
-    //pinMode(16, INPUT);
     context->display.begin();
-    //context->display.powerUp();
     context->display.setRotation(2);
     context->display.clearBuffer();
     context->display.fillScreen(EPD_WHITE);
-    //context->display.fillRect(0, 0, context->display.width(), context->display.height(), EPD_BLACK);
     context->display.display();
+    context->display.powerDown();
     context->display.setFont(&FreeSans9pt7b);
-    
-    //blankDisplay(context);
-    //vTaskDelay(8000);
-    //while (digitalRead(16))
-    //{
-   //     vTaskDelay(100); 
-   // }
-    /*
-    context->display.clearBuffer();
-    
-    context->display.display();
-    while (!digitalRead(16))
-    {
-        vTaskDelay(100); 
-    }
-    context->display.clearBuffer();
-    context->display.fillScreen(EPD_BLACK);
-    context->display.display();
-    while (!digitalRead(16))
-    {
-        vTaskDelay(100); 
-    }
-    context->display.clearBuffer();
-    context->display.fillScreen(EPD_WHITE);
-    context->display.display();
-    while (!digitalRead(16))
-    {
-        vTaskDelay(100); 
-    }
-*/
+    markBootPhase(context->boot_profile, BOOT_PHASE_EPD_READY);
+
+    EpdUpdate update;
     for (;;)
     {
-        if (xQueueReceive(context->epdQueue, NULL, portMAX_DELAY))
+        if (xQueueReceive(context->epdQueue, &update, portMAX_DELAY))
         {
-            Serial.println("[EPD] Updating physical display.");
-            
-            context->display.powerUp();
-            vTaskDelay(100);
-            context->display.display();
-            vTaskDelay(100);
+            // Let a burst of requests settle, then refresh once with the latest frame
+            EpdRefreshState &refreshes = context->epd_refreshes;
+            EpdUpdate batch = {0, 0, 0, 0, false, false};
+            addEpdRequest(refreshes, batch, update);
+            TickType_t burstStart = xTaskGetTickCount();
+            while (xTaskGetTickCount() - burstStart < pdMS_TO_TICKS(EPD_SETTLE_MAX_MS) &&
+                   xQueueReceive(context->epdQueue, &update, pdMS_TO_TICKS(EPD_SETTLE_MS)))
+            {
+                addEpdRequest(refreshes, batch, update);
+            }
+
+            EpdUpdate presented;
+            GFXcanvas1 *frame = context->epd_frames.take(presented);
+            EpdRefresh refresh = planEpdRefresh(refreshes, batch, frame, presented);
+            if (frame)
+            {
+                // Copy the frame into the display's own buffer, which only this task touches.
+                // Only the rows of the batch differ from what the display holds.
+                int16_t w = context->display.width();
+                int16_t top, rows;
+                updateRows(batch, context->display.height(), top, rows);
+                const uint8_t *firstRow = frame->getBuffer() + top * ((w + 7) / 8);
+                context->display.drawBitmap(0, top, firstRow, w, rows, EPD_BLACK, EPD_WHITE);
+                context->epd_frames.release();
+            }
+
+            if (refresh == EpdRefresh::NONE)
+            {
+                if (frame)
+                {
+                    Serial.printf("[EPD] Frame unchanged, refresh skipped (suppressed: %u)\n", refreshes.suppressed);
+                }
+                continue;
+            }
+
+            bool full = refresh == EpdRefresh::FULL;
+            uint32_t refreshStart = micros();
+
+            // display() and displayPartial() power the panel up themselves and
+            // wait on the busy line; it goes back into deep sleep afterwards
+            if (full)
+            {
+                context->display.display();
+            }
+            else
+            {
+                context->display.displayPartial(batch.x, batch.y, batch.x + batch.w - 1, batch.y + batch.h - 1);
+            }
             context->display.powerDown();
-            //while (digitalRead(16))
-            //{
-            //vTaskDelay(5000); 
-           // }
+
+            uint32_t elapsed = micros() - refreshStart;
+            context->epd_refresh.record(elapsed);
+            context->epd_active_ms += elapsed / 1000;
+            Serial.printf("[EPD] %s refresh of %dx%d in %u ms (full: %u, partial: %u, requested: %u)\n",
+                          full ? "Full" : "Partial", full ? context->display.width() : batch.w,
+                          full ? context->display.height() : batch.h, elapsed / 1000,
+                          refreshes.full, refreshes.partial, refreshes.requests);
         }
     }
 }
 
 // --- Helper Function Implementations ---
 
-static bool initializeFromRtc(AppContext *context)
+// The cached timezone is refreshed at most once a day, or sooner when the
+// clock is on a different access point, which may mean it was moved.
+static bool timezoneRefreshDue(AppContext *context)
 {
-    if (!context->rtc.begin())
-    {
-        Serial.println("[ERROR] Couldn't find RTC! Clock will not keep time without power.");
-        return false;
-    }
-
-    if (context->rtc.lostPower())
-    {
-        Serial.println("[WARN] RTC lost power. Setting to compile time as fallback.");
-        context->rtc.adjust(DateTime(F(__DATE__), F(__TIME__)));
-    }
-
-    DateTime rtcnow = context->rtc.now();
-    if (rtcnow.year() < 2024)
+    uint32_t fetched = context->preferences.getUInt(NVS_TZ_FETCHED_KEY, 0);
+    String network = context->preferences.getString(NVS_TZ_NETWORK_KEY, "");
+    time_t now_utc;
+    time(&now_utc);
+    if (network != WiFi.BSSIDstr())
     {
-        Serial.printf("[WARN] RTC has an invalid time (Year: %d). Waiting for WiFi sync.\n", rtcnow.year());
-        return false;
+        Serial.println("[Time Sync] Network changed since the timezone was fetched.");
+        return true;
     }
+    return fetched == 0 || now_utc - (time_t)fetched >= TZ_REFRESH_INTERVAL_S;
+}
 
-    struct timeval tv = {.tv_sec = static_cast<time_t>(rtcnow.unixtime()), .tv_usec = 0};
-    settimeofday(&tv, NULL);
-    Serial.println("System time initialized from hardware RTC.");
-
-    String tz_string = context->preferences.getString(NVS_TZ_KEY, "");
-    if (tz_string.length() > 0)
-    {
-        strncpy(context->time_zone, tz_string.c_str(), sizeof(context->time_zone) - 1);
-        setenv("TZ", tz_string.c_str(), 1);
-        tzset();
-        Serial.printf("Timezone set from NVS: %s\n", context->time_zone);
-    }
-    else
+static void markTimezoneFetched(AppContext *context)
+{
+    time_t now_utc;
+    time(&now_utc);
+    // Before NTP and without a working RTC the clock can be decades off;
+    // leave the refresh due rather than store a bogus fetch time.
+    if (now_utc >= MIN_VALID_EPOCH)
     {
-        Serial.println("Timezone not yet known, defaulting to UTC for now.");
+        context->preferences.putUInt(NVS_TZ_FETCHED_KEY, (uint32_t)now_utc);
     }
-
-    SystemCommand cmd = {SystemCommandType::START_CLOCK_DISPLAY};
-    xQueueSend(context->systemCommandQueue, &cmd, 0);
-    return true;
+    context->preferences.putString(NVS_TZ_NETWORK_KEY, WiFi.BSSIDstr().c_str());
 }
 
-static bool getTimezoneAndSync(AppContext *context)
+static bool fetchTimezone(AppContext *context)
 {
     WiFiClientSecure client;
     client.setCACert(root_ca_worldtimeapi);
     HTTPClient http;
     bool tz_success = false;
 
-    // --- Retry loop for fetching timezone ---
-    for (int i = 0; i < MAX_SYNC_RETRIES; ++i)
+    if (http.begin(client, TIME_API_URL))
     {
-        Serial.printf("[Time Sync] Fetching timezone, attempt %d/%d...\n", i + 1, MAX_SYNC_RETRIES);
-        if (http.begin(client, TIME_API_URL))
-        {
-            http.setConnectTimeout(8000);
-            int httpCode = http.GET();
+        http.setConnectTimeout(8000);
+        int httpCode = http.GET();
 
-            if (httpCode == HTTP_CODE_OK)
+        if (httpCode == HTTP_CODE_OK)
+        {
+            JsonDocument doc;
+            if (deserializeJson(doc, http.getStream()).code() == DeserializationError::Ok)
             {
-                JsonDocument doc;
-                if (deserializeJson(doc, http.getStream()).code() == DeserializationError::Ok)
+                const char *tz_iana = doc["timezone"];
+                if (tz_iana)
                 {
-                    const char *tz_iana = doc["timezone"];
-                    if (tz_iana)
-                    {
-                        const char *tz_posix = TzDbLookup::getPosix(tz_iana);
-                        strncpy(context->time_zone, tz_posix, sizeof(context->time_zone) - 1);
-                        Serial.printf("[Time Sync] Fetched Timezone: %s (POSIX: %s)\n", tz_iana, context->time_zone);
-                        context->preferences.putString(NVS_TZ_KEY, context->time_zone);
-                        tz_success = true;
-                        http.end();
-                        break; // Exit retry loop on success
-                    }
+                    const char *tz_posix = TzDbLookup::getPosix(tz_iana);
+                    strncpy(context->time_zone, tz_posix, sizeof(context->time_zone) - 1);
+                    Serial.printf("[Time Sync] Fetched Timezone: %s (POSIX: %s)\n", tz_iana, context->time_zone);
+                    context->preferences.putString(NVS_TZ_KEY, context->time_zone);
+                    tz_success = true;
                 }
             }
-            http.end();
         }
-        Serial.println("[Time Sync] Failed to fetch timezone on this attempt.");
-        vTaskDelay(pdMS_TO_TICKS(RETRY_DELAY_MS));
+        http.end();
     }
+    return tz_success;
+}
 
-    if (!tz_success)
+static void startSync(AppContext *context, TimeSync &sync)
+{
+    // The task starts before setup() restored the time from the RTC and the
+    // timezone from NVS, so WiFi can connect meanwhile. An NTP time or a
+    // fetched timezone must not be overwritten by that restore.
+    xEventGroupWaitBits(context->bootEvents, BOOT_RTC_READY, pdFALSE, pdTRUE, portMAX_DELAY);
+
+    sync.attempt = 0;
+    sync.nextStepAt = millis();
+    sync.timezoneAfterNtp = context->preferences.isKey(NVS_TZ_KEY);
+    if (sync.timezoneAfterNtp)
+    {
+        Serial.println("[Time Sync] Starting time sync with the cached timezone.");
+        sync.state = SyncState::START_NTP;
+    }
+    else
     {
-        Serial.println("[Time Sync] Failed to fetch timezone after all retries.");
-        context->display.setTextColor(EPD_BLACK);
-        context->display.println("Timezone Fetch Failed.");
-        xQueueSend(context->epdQueue, NULL, portMAX_DELAY);
-        return false;
+        Serial.println("[Time Sync] Starting time sync.");
+        sync.state = SyncState::FETCH_TIMEZONE;
     }
+}
 
-    // --- Retry loop for NTP sync ---
-    for (int i = 0; i < MAX_SYNC_RETRIES; ++i)
+static void cancelSync(TimeSync &sync, const char *reason)
+{
+    if (sync.state != SyncState::IDLE)
     {
-        Serial.printf("[Time Sync] Syncing with NTP server, attempt %d/%d...\n", i + 1, MAX_SYNC_RETRIES);
-        configTzTime(context->time_zone, NTP_SERVER_1, NTP_SERVER_2);
+        Serial.printf("[Time Sync] Cancelled: %s\n", reason);
+        sync.state = SyncState::IDLE;
+    }
+}
+
+static TickType_t syncTimeout(const TimeSync &sync)
+{
+    if (sync.state == SyncState::IDLE)
+    {
+        return portMAX_DELAY;
+    }
+    int32_t remaining = (int32_t)(sync.nextStepAt - millis());
+    return remaining > 0 ? pdMS_TO_TICKS(remaining) : 0;
+}
 
-        struct tm timeinfo;
-        if (getLocalTime(&timeinfo, 15000))
-        { // 15-second timeout for NTP
-            Serial.println("[Time Sync] System time synced via NTP.");
+// The system clock is only checked between syncs; a sync sets it anyway.
+static TickType_t clockCheckTimeout(const TimeSync &sync, uint32_t lastCheck)
+{
+    if (sync.state != SyncState::IDLE)
+    {
+        return portMAX_DELAY;
+    }
+    int32_t remaining = (int32_t)(lastCheck + RTC_CLOCK_CHECK_INTERVAL_S * 1000 - millis());
+    return remaining > 0 ? pdMS_TO_TICKS(remaining) : 0;
+}
+
+// Exponential backoff with "equal jitter": half the delay is fixed, the other
+// half random, so clocks that lost WiFi together do not retry in lockstep.
+static uint32_t backoffDelay(uint8_t attempt)
+{
+    uint32_t delay = SYNC_BACKOFF_MAX_MS;
+    if (attempt < 16)
+    {
+        delay = min((uint32_t)RETRY_DELAY_MS << attempt, (uint32_t)SYNC_BACKOFF_MAX_MS);
+    }
+    return delay / 2 + esp_random() % (delay / 2 + 1);
+}
 
-            time_t now_utc;
-            time(&now_utc);
-            context->rtc.adjust(DateTime(now_utc));
-            Serial.println("[Time Sync] RTC has been updated with correct UTC time.");
+/**
+ * @brief Schedules the next attempt of the current sync phase, or gives up.
+ * @param context Pointer to the shared application context.
+ * @param sync The sync in progress.
+ * @param retryState The state that makes the next attempt.
+ * @param failMessage Shown on the e-paper display when giving up.
+ */
+static void retrySync(AppContext *context, TimeSync &sync, SyncState retryState, const char *failMessage)
+{
+    if (++sync.attempt >= MAX_SYNC_RETRIES)
+    {
+        Serial.printf("[Time Sync] %s after %d attempts.\n", failMessage, MAX_SYNC_RETRIES);
+        sync.state = SyncState::IDLE;
+        context->status_screen.set(STATUS_STATE, "%s", failMessage);
+        showStatus(context);
+        return;
+    }
+    uint32_t delay = backoffDelay(sync.attempt - 1);
+    Serial.printf("[Time Sync] Retrying in %u ms.\n", delay);
+    sync.state = retryState;
+    sync.nextStepAt = millis() + delay;
+}
 
+static void stepSync(AppContext *context, TimeSync &sync)
+{
+    switch (sync.state)
+    {
+    case SyncState::FETCH_TIMEZONE:
+    {
+        Serial.printf("[Time Sync] Fetching timezone, attempt %d/%d...\n", sync.attempt + 1, MAX_SYNC_RETRIES);
+        uint32_t start = millis();
+        bool ok = fetchTimezone(context);
+        context->sync_timezone.record(millis() - start, ok);
+        if (!ok)
+        {
+            retrySync(context, sync, SyncState::FETCH_TIMEZONE, "Timezone Fetch Failed.");
+            break;
+        }
+        markTimezoneFetched(context);
+        if (sync.timezoneAfterNtp)
+        {
+            // Background refresh: the time is already synced, only apply the timezone
             setenv("TZ", context->time_zone, 1);
             tzset();
-            char time_buf[64];
-            localtime_r(&now_utc, &timeinfo);
-            strftime(time_buf, sizeof(time_buf), "%b %d %H:%M:%S %Z", &timeinfo);
-            //context->display.println("Sync successful!");
-            context->display.printf("Sync: %s\n", time_buf);
-            xQueueSend(context->epdQueue, NULL,portMAX_DELAY);
-
-            if (!context->time_is_valid)
-            {
-                SystemCommand cmd = {SystemCommandType::START_CLOCK_DISPLAY};
-                xQueueSend(context->systemCommandQueue, &cmd, 0);
-            }
-            return true; // Return true on success
+            context->tz_generation++;
+            sync.state = SyncState::IDLE;
+            break;
         }
-        Serial.println("[Time Sync] Failed to get local time from NTP server on this attempt.");
-        vTaskDelay(pdMS_TO_TICKS(RETRY_DELAY_MS));
+        sync.state = SyncState::START_NTP;
+        sync.attempt = 0;
+        sync.nextStepAt = millis();
+    }
+    break;
+
+    case SyncState::START_NTP:
+        Serial.printf("[Time Sync] Syncing with NTP server, attempt %d/%d...\n", sync.attempt + 1, MAX_SYNC_RETRIES);
+        applySyncInterval(context);
+        configTzTime(context->time_zone, NTP_SERVER_1, NTP_SERVER_2);
+        context->tz_generation++;
+        sync.state = SyncState::WAIT_NTP;
+        sync.attemptStart = millis();
+        sync.nextStepAt = sync.attemptStart + NTP_SYNC_TIMEOUT_MS;
+        break;
+
+    case SyncState::WAIT_NTP:
+        // No SNTP_SYNC event before the deadline
+        context->sync_ntp.record(millis() - sync.attemptStart, false);
+        retrySync(context, sync, SyncState::START_NTP, "NTP Sync Fail.");
+        break;
+
+    case SyncState::IDLE:
+        break;
     }
+}
+
+static void completeSync(AppContext *context, TimeSync &sync)
+{
+    context->sync_ntp.record(millis() - sync.attemptStart, true);
+    sync.state = SyncState::IDLE;
+    Serial.println("[WiFi Task] Time sync successful.");
+    markBootPhase(context->boot_profile, BOOT_PHASE_NTP_SYNCED);
 
-    Serial.println("[Time Sync] Failed to sync NTP after all retries.");
-    context->display.setTextColor(EPD_BLACK);
-    context->display.println("NTP Sync Fail.");
-    xQueueSend(context->epdQueue, NULL, portMAX_DELAY);
-    return false;
+    if (sync.timezoneAfterNtp && timezoneRefreshDue(context))
+    {
+        Serial.println("[Time Sync] Refreshing the cached timezone in the background.");
+        sync.state = SyncState::FETCH_TIMEZONE;
+        sync.attempt = 0;
+        sync.nextStepAt = millis();
+    }
+}
+
+// Repaints the changed status regions off-screen and hands the frame to the EPD task.
+static void showStatus(AppContext *context)
+{
+    if (!context->status_screen.dirty())
+    {
+        return;
+    }
+    EpdUpdate update = context->status_screen.draw(context->epd_frames.back());
+    context->epd_frames.present(context->epdQueue, update);
 }
 
 static void blankDisplay(AppContext *context)
@@ -3,135 +3,105 @@
  * @brief Implements the logic for displaying time on the word clock matrix.
  *
  * This file translates hours and minutes into the specific words that need
- * to be lit up on the LED display.
+ * to be lit up on the LED display. Every sentence the clock can show is
+ * worked out at compile time into a table of LED masks, and changes between
+ * sentences are crossfaded by a MaskTransition.
  */
 
 #include "time_display.h"
 #include "word_layout.h"
+#include "time_golden.h"
 #include "animations.h"
 
-// --- Helper for animations that progress across a sentence ---
-static bool firstWord = true;
+static_assert(NUM_LEDS <= 64, "LedMask holds one bit per LED");
 
-void writeWord(const Word& w, CRGB* ledArray, CHSV color, ColorScheme scheme) {
-    // This function now acts as a dispatcher to the correct animation function.
-    switch (scheme) {
-        case RAINBOW_RIPPLE:
-            rainbowRipple(w, ledArray, color);
-            break;
-        case NOISE_FIELD:
-            noiseFieldWords(w, ledArray, color);
-            break;
-        case RANDOMIZED_WORDS:
-            randomizedWordColors(w, ledArray, color);
-            break;
-        case RAINBOW_SENTENCE:
-            rainbowSentences(w, ledArray, color);
-            break;
-        //case TIME_COLOR_CHANGE:
-        //    timeColorChange(w, ledArray, color);
-        //    break;
-        default: // Fallback to a simple solid color
-            for (int i = 0; i < w.wordLength; i++) {
-                ledArray[w.startIndex + i] = color;
+// --- Phrase Table ---
+// LED masks for the words that make up the minute part of a sentence.
+static constexpr LedMask M_IT       = wordMask(WORD_IT);
+static constexpr LedMask M_IS       = wordMask(WORD_IS);
+static constexpr LedMask M_TEN_MIN  = wordMask(WORD_TEN_MIN);
+static constexpr LedMask M_HALF     = wordMask(WORD_HALF);
+static constexpr LedMask M_QUARTER  = wordMask(WORD_QUARTER);
+static constexpr LedMask M_TWENTY   = wordMask(WORD_TWENTY);
+static constexpr LedMask M_FIVE_MIN = wordMask(WORD_FIVE_MIN);
+static constexpr LedMask M_MINUTES  = wordMask(WORD_MINUTES);
+static constexpr LedMask M_PAST     = wordMask(WORD_PAST);
+static constexpr LedMask M_TO       = wordMask(WORD_TO);
+static constexpr LedMask M_OCLOCK   = wordMask(WORD_OCLOCK);
+
+// Minute part of the sentence for each 5-minute slot.
+static constexpr LedMask minutePhrases[12] = {
+    M_OCLOCK,                                   // :00
+    M_FIVE_MIN | M_MINUTES | M_PAST,            // :05
+    M_TEN_MIN | M_MINUTES | M_PAST,             // :10
+    M_QUARTER | M_PAST,                         // :15
+    M_TWENTY | M_MINUTES | M_PAST,              // :20
+    M_TWENTY | M_FIVE_MIN | M_MINUTES | M_PAST, // :25
+    M_HALF | M_PAST,                            // :30
+    M_TWENTY | M_FIVE_MIN | M_MINUTES | M_TO,   // :35
+    M_TWENTY | M_MINUTES | M_TO,                // :40
+    M_QUARTER | M_TO,                           // :45
+    M_TEN_MIN | M_MINUTES | M_TO,               // :50
+    M_FIVE_MIN | M_MINUTES | M_TO,              // :55
+};
+
+struct PhraseTable {
+    LedMask mask[12][12]; // [hour % 12][minutes / 5]
+};
+
+static constexpr PhraseTable buildPhraseTable() {
+    PhraseTable table{};
+    for (int hour = 0; hour < 12; hour++) {
+        for (int slot = 0; slot < 12; slot++) {
+            int hour_to_display = (hour == 0) ? 12 : hour;
+            // "to" times name the next hour (e.g., "ten to five")
+            if (slot >= 7) {
+                hour_to_display = (hour_to_display % 12) + 1;
             }
-            break;
+            table.mask[hour][slot] = M_IT | M_IS | minutePhrases[slot]
+                                   | wordMask(static_cast<WordId>(WORD_ONE + hour_to_display - 1));
+        }
     }
+    return table;
 }
 
+static constexpr PhraseTable phraseTable = buildPhraseTable();
 
-void writeTime(int hours, int minutes, CRGB* ledArray, CHSV color, ColorScheme scheme) {
-    firstWord = true; // Reset for sentence-based animations
+static constexpr LedMask phraseMask(int hours, int minutes) {
+    return phraseTable.mask[hours % 12][minutes / 5];
+}
 
-    // Normalize to 12-hour format
-    if (hours >= 12) hours -= 12;
-    if (hours == 0) hours = 12;
+// Every minute of the day must light exactly the words of the original sentence.
+static constexpr int countGoldenMismatches() {
+    int mismatches = 0;
+    for (int hour = 0; hour < 24; hour++) {
+        for (int minute = 0; minute < 60; minute++) {
+            if (phraseMask(hour, minute) != goldenTimeMasks[hour][minute / 5]) {
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
 
-    fadeToBlackBy(ledArray, NUM_LEDS, 48);
-    writeWord(*W_IT, ledArray, color, scheme);
-    writeWord(*W_IS, ledArray, color, scheme);
+static_assert(countGoldenMismatches() == 0, "phrase table differs from goldenTimeMasks");
 
-    int roundedMinutes = (minutes / 5) * 5; // Round down to nearest 5 minutes
-    int hour_to_display = hours;
+// --- Rendering ---
 
-    // Adjust hour for "to" times (e.g., "ten to five")
-    if (minutes > 34) {
-        hour_to_display = (hours % 12) + 1;
-    }
+LedMask timeMask(int hours, int minutes) {
+    return phraseMask(hours, minutes);
+}
 
-    switch (roundedMinutes) {
-        case 0:
-            writeWord(*W_OCLOCK, ledArray, color, scheme);
-            break;
-        case 5:
-            writeWord(*W_FIVE_MIN, ledArray, color, scheme);
-            writeWord(*W_MINUTES, ledArray, color, scheme);
-            writeWord(*W_PAST, ledArray, color, scheme);
-            break;
-        case 10:
-            writeWord(*W_TEN_MIN, ledArray, color, scheme);
-            writeWord(*W_MINUTES, ledArray, color, scheme);
-            writeWord(*W_PAST, ledArray, color, scheme);
-            break;
-        case 15:
-            writeWord(*W_QUARTER, ledArray, color, scheme);
-            writeWord(*W_PAST, ledArray, color, scheme);
-            break;
-        case 20:
-            writeWord(*W_TWENTY, ledArray, color, scheme);
-            writeWord(*W_MINUTES, ledArray, color, scheme);
-            writeWord(*W_PAST, ledArray, color, scheme);
-            break;
-        case 25:
-            writeWord(*W_TWENTY, ledArray, color, scheme);
-            writeWord(*W_FIVE_MIN, ledArray, color, scheme);
-            writeWord(*W_MINUTES, ledArray, color, scheme);
-            writeWord(*W_PAST, ledArray, color, scheme);
-            break;
-        case 30:
-            writeWord(*W_HALF, ledArray, color, scheme);
-            writeWord(*W_PAST, ledArray, color, scheme);
-            break;
-        case 35:
-            writeWord(*W_TWENTY, ledArray, color, scheme);
-            writeWord(*W_FIVE_MIN, ledArray, color, scheme);
-            writeWord(*W_MINUTES, ledArray, color, scheme);
-            writeWord(*W_TO, ledArray, color, scheme);
-            break;
-        case 40:
-            writeWord(*W_TWENTY, ledArray, color, scheme);
-            writeWord(*W_MINUTES, ledArray, color, scheme);
-            writeWord(*W_TO, ledArray, color, scheme);
-            break;
-        case 45:
-            writeWord(*W_QUARTER, ledArray, color, scheme);
-            writeWord(*W_TO, ledArray, color, scheme);
-            break;
-        case 50:
-            writeWord(*W_TEN_MIN, ledArray, color, scheme);
-            writeWord(*W_MINUTES, ledArray, color, scheme);
-            writeWord(*W_TO, ledArray, color, scheme);
-            break;
-        case 55:
-            writeWord(*W_FIVE_MIN, ledArray, color, scheme);
-            writeWord(*W_MINUTES, ledArray, color, scheme);
-            writeWord(*W_TO, ledArray, color, scheme);
-            break;
-    }
+void writeTime(int hours, int minutes, CRGB* ledArray, CHSV color, uint8_t scheme,
+               MaskTransition& transition, uint32_t now) {
+    transition.setTarget(timeMask(hours, minutes), now);
 
-    switch (hour_to_display) {
-        case 1: writeWord(*W_ONE, ledArray, color, scheme); break;
-        case 2: writeWord(*W_TWO, ledArray, color, scheme); break;
-        case 3: writeWord(*W_THREE, ledArray, color, scheme); break;
-        case 4: writeWord(*W_FOUR, ledArray, color, scheme); break;
-        case 5: writeWord(*W_FIVE, ledArray, color, scheme); break;
-        case 6: writeWord(*W_SIX, ledArray, color, scheme); break;
-        case 7: writeWord(*W_SEVEN, ledArray, color, scheme); break;
-        case 8: writeWord(*W_EIGHT, ledArray, color, scheme); break;
-        case 9: writeWord(*W_NINE, ledArray, color, scheme); break;
-        case 10: writeWord(*W_TEN, ledArray, color, scheme); break;
-        case 11: writeWord(*W_ELEVEN, ledArray, color, scheme); break;
-        case 12: writeWord(*W_TWELVE, ledArray, color, scheme); break;
-    }
+    // Color both the outgoing and incoming words, then crossfade between them.
+    // Once settled only the incoming words are shown, so the outgoing ones must
+    // not be colored: schemes like the rainbow sentence step per colored LED.
+    LedMask colored = transition.active(now) ? (transition.from() | transition.to()) : transition.to();
+    CRGB frame[NUM_LEDS] = {};
+    renderColorScheme(scheme, colored,
+                      SchemeFrame{frame, color, now, (uint16_t)((hours % 24) * 60 + minutes)});
+    transition.render(frame, ledArray, now);
 }
-
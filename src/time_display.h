@@ -7,26 +7,31 @@
 
 #include <FastLED.h>
 #include "word_layout.h"
-#include "animations.h" // Needed for ColorScheme enum
+#include "color_schemes.h"
+#include "transition.h"
 
 /**
  * @brief Displays the given time on the LED matrix using words.
+ *
+ * When the sentence changes, the old and new words are crossfaded.
  * @param hours The current hour (0-23).
  * @param minutes The current minute (0-59).
  * @param ledArray Pointer to the CRGB LED array.
  * @param color The base color for the display.
- * @param scheme The color animation scheme to use.
+ * @param scheme Index of the registered color scheme to use.
+ * @param transition Crossfade state, kept by the caller between frames.
+ * @param now Current time in ms.
  */
-void writeTime(int hours, int minutes, CRGB* ledArray, CHSV color, ColorScheme scheme);
+void writeTime(int hours, int minutes, CRGB* ledArray, CHSV color, uint8_t scheme,
+               MaskTransition& transition, uint32_t now);
 
 /**
- * @brief Lights up a single word on the LED matrix.
- * @param w The Word struct defining the word to light up.
- * @param ledArray Pointer to the CRGB LED array.
- * @param color The base color for the display.
- * @param scheme The color animation scheme to use.
+ * @brief Returns the set of LEDs that spell out the given time.
+ * @param hours The current hour (0-23).
+ * @param minutes The current minute (0-59).
+ * @return Mask with one bit per lit LED.
  */
-void writeWord(const Word& w, CRGB* ledArray, CHSV color, ColorScheme scheme);
+LedMask timeMask(int hours, int minutes);
 
 #endif // TIME_DISPLAY_H
 
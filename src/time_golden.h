@@ -0,0 +1,356 @@
+/**
+ * @file time_golden.h
+ * @brief Reference LED masks for every sentence the clock can show.
+ *
+ * Recorded from the original switch-based writeTime(), one entry per hour of
+ * the day and 5-minute slot. This table is the regression gate for the phrase
+ * engine: time_display.cpp checks every (hour, minute) pair against it at
+ * compile time, and the console "day" command checks the rendered frames on
+ * the device. Never regenerate it from the phrase table it is meant to check.
+ */
+#ifndef TIME_GOLDEN_H
+#define TIME_GOLDEN_H
+
+#include "word_layout.h"
+
+// [hour (0-23)][minutes / 5]
+inline constexpr LedMask goldenTimeMasks[24][12] = {
+    {
+        0x03f8000000000006ULL, // 00:00 it is twelve oclock
+        0x00380000007f8006ULL, // 00:05 it is five minutes past twelve
+        0x00380000007e001eULL, // 00:10 it is ten minutes past twelve
+        0x0038000000600786ULL, // 00:15 it is quarter past twelve
+        0x00380000007e7806ULL, // 00:20 it is twenty minutes past twelve
+        0x00380000007ff806ULL, // 00:25 it is twenty five minutes past twelve
+        0x0038000000600066ULL, // 00:30 it is half past twelve
+        0x00000000039ff806ULL, // 00:35 it is twenty five minutes to one
+        0x00000000039e7806ULL, // 00:40 it is twenty minutes to one
+        0x0000000003800786ULL, // 00:45 it is quarter to one
+        0x00000000039e001eULL, // 00:50 it is ten minutes to one
+        0x00000000039f8006ULL, // 00:55 it is five minutes to one
+    },
+    {
+        0x03c0000003000006ULL, // 01:00 it is one oclock
+        0x00000000037f8006ULL, // 01:05 it is five minutes past one
+        0x00000000037e001eULL, // 01:10 it is ten minutes past one
+        0x0000000003600786ULL, // 01:15 it is quarter past one
+        0x00000000037e7806ULL, // 01:20 it is twenty minutes past one
+        0x00000000037ff806ULL, // 01:25 it is twenty five minutes past one
+        0x0000000003600066ULL, // 01:30 it is half past one
+        0x000000000c9ff806ULL, // 01:35 it is twenty five minutes to two
+        0x000000000c9e7806ULL, // 01:40 it is twenty minutes to two
+        0x000000000c800786ULL, // 01:45 it is quarter to two
+        0x000000000c9e001eULL, // 01:50 it is ten minutes to two
+        0x000000000c9f8006ULL, // 01:55 it is five minutes to two
+    },
+    {
+        0x03c000000c000006ULL, // 02:00 it is two oclock
+        0x000000000c7f8006ULL, // 02:05 it is five minutes past two
+        0x000000000c7e001eULL, // 02:10 it is ten minutes past two
+        0x000000000c600786ULL, // 02:15 it is quarter past two
+        0x000000000c7e7806ULL, // 02:20 it is twenty minutes past two
+        0x000000000c7ff806ULL, // 02:25 it is twenty five minutes past two
+        0x000000000c600066ULL, // 02:30 it is half past two
+        0x00000000709ff806ULL, // 02:35 it is twenty five minutes to three
+        0x00000000709e7806ULL, // 02:40 it is twenty minutes to three
+        0x0000000070800786ULL, // 02:45 it is quarter to three
+        0x00000000709e001eULL, // 02:50 it is ten minutes to three
+        0x00000000709f8006ULL, // 02:55 it is five minutes to three
+    },
+    {
+        0x03c0000070000006ULL, // 03:00 it is three oclock
+        0x00000000707f8006ULL, // 03:05 it is five minutes past three
+        0x00000000707e001eULL, // 03:10 it is ten minutes past three
+        0x0000000070600786ULL, // 03:15 it is quarter past three
+        0x00000000707e7806ULL, // 03:20 it is twenty minutes past three
+        0x00000000707ff806ULL, // 03:25 it is twenty five minutes past three
+        0x0000000070600066ULL, // 03:30 it is half past three
+        0x00000001809ff806ULL, // 03:35 it is twenty five minutes to four
+        0x00000001809e7806ULL, // 03:40 it is twenty minutes to four
+        0x0000000180800786ULL, // 03:45 it is quarter to four
+        0x00000001809e001eULL, // 03:50 it is ten minutes to four
+        0x00000001809f8006ULL, // 03:55 it is five minutes to four
+    },
+    {
+        0x03c0000180000006ULL, // 04:00 it is four oclock
+        0x00000001807f8006ULL, // 04:05 it is five minutes past four
+        0x00000001807e001eULL, // 04:10 it is ten minutes past four
+        0x0000000180600786ULL, // 04:15 it is quarter past four
+        0x00000001807e7806ULL, // 04:20 it is twenty minutes past four
+        0x00000001807ff806ULL, // 04:25 it is twenty five minutes past four
+        0x0000000180600066ULL, // 04:30 it is half past four
+        0x00000006009ff806ULL, // 04:35 it is twenty five minutes to five
+        0x00000006009e7806ULL, // 04:40 it is twenty minutes to five
+        0x0000000600800786ULL, // 04:45 it is quarter to five
+        0x00000006009e001eULL, // 04:50 it is ten minutes to five
+        0x00000006009f8006ULL, // 04:55 it is five minutes to five
+    },
+    {
+        0x03c0000600000006ULL, // 05:00 it is five oclock
+        0x00000006007f8006ULL, // 05:05 it is five minutes past five
+        0x00000006007e001eULL, // 05:10 it is ten minutes past five
+        0x0000000600600786ULL, // 05:15 it is quarter past five
+        0x00000006007e7806ULL, // 05:20 it is twenty minutes past five
+        0x00000006007ff806ULL, // 05:25 it is twenty five minutes past five
+        0x0000000600600066ULL, // 05:30 it is half past five
+        0x00000018009ff806ULL, // 05:35 it is twenty five minutes to six
+        0x00000018009e7806ULL, // 05:40 it is twenty minutes to six
+        0x0000001800800786ULL, // 05:45 it is quarter to six
+        0x00000018009e001eULL, // 05:50 it is ten minutes to six
+        0x00000018009f8006ULL, // 05:55 it is five minutes to six
+    },
+    {
+        0x03c0001800000006ULL, // 06:00 it is six oclock
+        0x00000018007f8006ULL, // 06:05 it is five minutes past six
+        0x00000018007e001eULL, // 06:10 it is ten minutes past six
+        0x0000001800600786ULL, // 06:15 it is quarter past six
+        0x00000018007e7806ULL, // 06:20 it is twenty minutes past six
+        0x00000018007ff806ULL, // 06:25 it is twenty five minutes past six
+        0x0000001800600066ULL, // 06:30 it is half past six
+        0x000000e0009ff806ULL, // 06:35 it is twenty five minutes to seven
+        0x000000e0009e7806ULL, // 06:40 it is twenty minutes to seven
+        0x000000e000800786ULL, // 06:45 it is quarter to seven
+        0x000000e0009e001eULL, // 06:50 it is ten minutes to seven
+        0x000000e0009f8006ULL, // 06:55 it is five minutes to seven
+    },
+    {
+        0x03c000e000000006ULL, // 07:00 it is seven oclock
+        0x000000e0007f8006ULL, // 07:05 it is five minutes past seven
+        0x000000e0007e001eULL, // 07:10 it is ten minutes past seven
+        0x000000e000600786ULL, // 07:15 it is quarter past seven
+        0x000000e0007e7806ULL, // 07:20 it is twenty minutes past seven
+        0x000000e0007ff806ULL, // 07:25 it is twenty five minutes past seven
+        0x000000e000600066ULL, // 07:30 it is half past seven
+        0x00000700009ff806ULL, // 07:35 it is twenty five minutes to eight
+        0x00000700009e7806ULL, // 07:40 it is twenty minutes to eight
+        0x0000070000800786ULL, // 07:45 it is quarter to eight
+        0x00000700009e001eULL, // 07:50 it is ten minutes to eight
+        0x00000700009f8006ULL, // 07:55 it is five minutes to eight
+    },
+    {
+        0x03c0070000000006ULL, // 08:00 it is eight oclock
+        0x00000700007f8006ULL, // 08:05 it is five minutes past eight
+        0x00000700007e001eULL, // 08:10 it is ten minutes past eight
+        0x0000070000600786ULL, // 08:15 it is quarter past eight
+        0x00000700007e7806ULL, // 08:20 it is twenty minutes past eight
+        0x00000700007ff806ULL, // 08:25 it is twenty five minutes past eight
+        0x0000070000600066ULL, // 08:30 it is half past eight
+        0x00001800009ff806ULL, // 08:35 it is twenty five minutes to nine
+        0x00001800009e7806ULL, // 08:40 it is twenty minutes to nine
+        0x0000180000800786ULL, // 08:45 it is quarter to nine
+        0x00001800009e001eULL, // 08:50 it is ten minutes to nine
+        0x00001800009f8006ULL, // 08:55 it is five minutes to nine
+    },
+    {
+        0x03c0180000000006ULL, // 09:00 it is nine oclock
+        0x00001800007f8006ULL, // 09:05 it is five minutes past nine
+        0x00001800007e001eULL, // 09:10 it is ten minutes past nine
+        0x0000180000600786ULL, // 09:15 it is quarter past nine
+        0x00001800007e7806ULL, // 09:20 it is twenty minutes past nine
+        0x00001800007ff806ULL, // 09:25 it is twenty five minutes past nine
+        0x0000180000600066ULL, // 09:30 it is half past nine
+        0x00006000009ff806ULL, // 09:35 it is twenty five minutes to ten
+        0x00006000009e7806ULL, // 09:40 it is twenty minutes to ten
+        0x0000600000800786ULL, // 09:45 it is quarter to ten
+        0x00006000009e001eULL, // 09:50 it is ten minutes to ten
+        0x00006000009f8006ULL, // 09:55 it is five minutes to ten
+    },
+    {
+        0x03c0600000000006ULL, // 10:00 it is ten oclock
+        0x00006000007f8006ULL, // 10:05 it is five minutes past ten
+        0x00006000007e001eULL, // 10:10 it is ten minutes past ten
+        0x0000600000600786ULL, // 10:15 it is quarter past ten
+        0x00006000007e7806ULL, // 10:20 it is twenty minutes past ten
+        0x00006000007ff806ULL, // 10:25 it is twenty five minutes past ten
+        0x0000600000600066ULL, // 10:30 it is half past ten
+        0x00078000009ff806ULL, // 10:35 it is twenty five minutes to eleven
+        0x00078000009e7806ULL, // 10:40 it is twenty minutes to eleven
+        0x0007800000800786ULL, // 10:45 it is quarter to eleven
+        0x00078000009e001eULL, // 10:50 it is ten minutes to eleven
+        0x00078000009f8006ULL, // 10:55 it is five minutes to eleven
+    },
+    {
+        0x03c7800000000006ULL, // 11:00 it is eleven oclock
+        0x00078000007f8006ULL, // 11:05 it is five minutes past eleven
+        0x00078000007e001eULL, // 11:10 it is ten minutes past eleven
+        0x0007800000600786ULL, // 11:15 it is quarter past eleven
+        0x00078000007e7806ULL, // 11:20 it is twenty minutes past eleven
+        0x00078000007ff806ULL, // 11:25 it is twenty five minutes past eleven
+        0x0007800000600066ULL, // 11:30 it is half past eleven
+        0x00380000009ff806ULL, // 11:35 it is twenty five minutes to twelve
+        0x00380000009e7806ULL, // 11:40 it is twenty minutes to twelve
+        0x0038000000800786ULL, // 11:45 it is quarter to twelve
+        0x00380000009e001eULL, // 11:50 it is ten minutes to twelve
+        0x00380000009f8006ULL, // 11:55 it is five minutes to twelve
+    },
+    {
+        0x03f8000000000006ULL, // 12:00 it is twelve oclock
+        0x00380000007f8006ULL, // 12:05 it is five minutes past twelve
+        0x00380000007e001eULL, // 12:10 it is ten minutes past twelve
+        0x0038000000600786ULL, // 12:15 it is quarter past twelve
+        0x00380000007e7806ULL, // 12:20 it is twenty minutes past twelve
+        0x00380000007ff806ULL, // 12:25 it is twenty five minutes past twelve
+        0x0038000000600066ULL, // 12:30 it is half past twelve
+        0x00000000039ff806ULL, // 12:35 it is twenty five minutes to one
+        0x00000000039e7806ULL, // 12:40 it is twenty minutes to one
+        0x0000000003800786ULL, // 12:45 it is quarter to one
+        0x00000000039e001eULL, // 12:50 it is ten minutes to one
+        0x00000000039f8006ULL, // 12:55 it is five minutes to one
+    },
+    {
+        0x03c0000003000006ULL, // 13:00 it is one oclock
+        0x00000000037f8006ULL, // 13:05 it is five minutes past one
+        0x00000000037e001eULL, // 13:10 it is ten minutes past one
+        0x0000000003600786ULL, // 13:15 it is quarter past one
+        0x00000000037e7806ULL, // 13:20 it is twenty minutes past one
+        0x00000000037ff806ULL, // 13:25 it is twenty five minutes past one
+        0x0000000003600066ULL, // 13:30 it is half past one
+        0x000000000c9ff806ULL, // 13:35 it is twenty five minutes to two
+        0x000000000c9e7806ULL, // 13:40 it is twenty minutes to two
+        0x000000000c800786ULL, // 13:45 it is quarter to two
+        0x000000000c9e001eULL, // 13:50 it is ten minutes to two
+        0x000000000c9f8006ULL, // 13:55 it is five minutes to two
+    },
+    {
+        0x03c000000c000006ULL, // 14:00 it is two oclock
+        0x000000000c7f8006ULL, // 14:05 it is five minutes past two
+        0x000000000c7e001eULL, // 14:10 it is ten minutes past two
+        0x000000000c600786ULL, // 14:15 it is quarter past two
+        0x000000000c7e7806ULL, // 14:20 it is twenty minutes past two
+        0x000000000c7ff806ULL, // 14:25 it is twenty five minutes past two
+        0x000000000c600066ULL, // 14:30 it is half past two
+        0x00000000709ff806ULL, // 14:35 it is twenty five minutes to three
+        0x00000000709e7806ULL, // 14:40 it is twenty minutes to three
+        0x0000000070800786ULL, // 14:45 it is quarter to three
+        0x00000000709e001eULL, // 14:50 it is ten minutes to three
+        0x00000000709f8006ULL, // 14:55 it is five minutes to three
+    },
+    {
+        0x03c0000070000006ULL, // 15:00 it is three oclock
+        0x00000000707f8006ULL, // 15:05 it is five minutes past three
+        0x00000000707e001eULL, // 15:10 it is ten minutes past three
+        0x0000000070600786ULL, // 15:15 it is quarter past three
+        0x00000000707e7806ULL, // 15:20 it is twenty minutes past three
+        0x00000000707ff806ULL, // 15:25 it is twenty five minutes past three
+        0x0000000070600066ULL, // 15:30 it is half past three
+        0x00000001809ff806ULL, // 15:35 it is twenty five minutes to four
+        0x00000001809e7806ULL, // 15:40 it is twenty minutes to four
+        0x0000000180800786ULL, // 15:45 it is quarter to four
+        0x00000001809e001eULL, // 15:50 it is ten minutes to four
+        0x00000001809f8006ULL, // 15:55 it is five minutes to four
+    },
+    {
+        0x03c0000180000006ULL, // 16:00 it is four oclock
+        0x00000001807f8006ULL, // 16:05 it is five minutes past four
+        0x00000001807e001eULL, // 16:10 it is ten minutes past four
+        0x0000000180600786ULL, // 16:15 it is quarter past four
+        0x00000001807e7806ULL, // 16:20 it is twenty minutes past four
+        0x00000001807ff806ULL, // 16:25 it is twenty five minutes past four
+        0x0000000180600066ULL, // 16:30 it is half past four
+        0x00000006009ff806ULL, // 16:35 it is twenty five minutes to five
+        0x00000006009e7806ULL, // 16:40 it is twenty minutes to five
+        0x0000000600800786ULL, // 16:45 it is quarter to five
+        0x00000006009e001eULL, // 16:50 it is ten minutes to five
+        0x00000006009f8006ULL, // 16:55 it is five minutes to five
+    },
+    {
+        0x03c0000600000006ULL, // 17:00 it is five oclock
+        0x00000006007f8006ULL, // 17:05 it is five minutes past five
+        0x00000006007e001eULL, // 17:10 it is ten minutes past five
+        0x0000000600600786ULL, // 17:15 it is quarter past five
+        0x00000006007e7806ULL, // 17:20 it is twenty minutes past five
+        0x00000006007ff806ULL, // 17:25 it is twenty five minutes past five
+        0x0000000600600066ULL, // 17:30 it is half past five
+        0x00000018009ff806ULL, // 17:35 it is twenty five minutes to six
+        0x00000018009e7806ULL, // 17:40 it is twenty minutes to six
+        0x0000001800800786ULL, // 17:45 it is quarter to six
+        0x00000018009e001eULL, // 17:50 it is ten minutes to six
+        0x00000018009f8006ULL, // 17:55 it is five minutes to six
+    },
+    {
+        0x03c0001800000006ULL, // 18:00 it is six oclock
+        0x00000018007f8006ULL, // 18:05 it is five minutes past six
+        0x00000018007e001eULL, // 18:10 it is ten minutes past six
+        0x0000001800600786ULL, // 18:15 it is quarter past six
+        0x00000018007e7806ULL, // 18:20 it is twenty minutes past six
+        0x00000018007ff806ULL, // 18:25 it is twenty five minutes past six
+        0x0000001800600066ULL, // 18:30 it is half past six
+        0x000000e0009ff806ULL, // 18:35 it is twenty five minutes to seven
+        0x000000e0009e7806ULL, // 18:40 it is twenty minutes to seven
+        0x000000e000800786ULL, // 18:45 it is quarter to seven
+        0x000000e0009e001eULL, // 18:50 it is ten minutes to seven
+        0x000000e0009f8006ULL, // 18:55 it is five minutes to seven
+    },
+    {
+        0x03c000e000000006ULL, // 19:00 it is seven oclock
+        0x000000e0007f8006ULL, // 19:05 it is five minutes past seven
+        0x000000e0007e001eULL, // 19:10 it is ten minutes past seven
+        0x000000e000600786ULL, // 19:15 it is quarter past seven
+        0x000000e0007e7806ULL, // 19:20 it is twenty minutes past seven
+        0x000000e0007ff806ULL, // 19:25 it is twenty five minutes past seven
+        0x000000e000600066ULL, // 19:30 it is half past seven
+        0x00000700009ff806ULL, // 19:35 it is twenty five minutes to eight
+        0x00000700009e7806ULL, // 19:40 it is twenty minutes to eight
+        0x0000070000800786ULL, // 19:45 it is quarter to eight
+        0x00000700009e001eULL, // 19:50 it is ten minutes to eight
+        0x00000700009f8006ULL, // 19:55 it is five minutes to eight
+    },
+    {
+        0x03c0070000000006ULL, // 20:00 it is eight oclock
+        0x00000700007f8006ULL, // 20:05 it is five minutes past eight
+        0x00000700007e001eULL, // 20:10 it is ten minutes past eight
+        0x0000070000600786ULL, // 20:15 it is quarter past eight
+        0x00000700007e7806ULL, // 20:20 it is twenty minutes past eight
+        0x00000700007ff806ULL, // 20:25 it is twenty five minutes past eight
+        0x0000070000600066ULL, // 20:30 it is half past eight
+        0x00001800009ff806ULL, // 20:35 it is twenty five minutes to nine
+        0x00001800009e7806ULL, // 20:40 it is twenty minutes to nine
+        0x0000180000800786ULL, // 20:45 it is quarter to nine
+        0x00001800009e001eULL, // 20:50 it is ten minutes to nine
+        0x00001800009f8006ULL, // 20:55 it is five minutes to nine
+    },
+    {
+        0x03c0180000000006ULL, // 21:00 it is nine oclock
+        0x00001800007f8006ULL, // 21:05 it is five minutes past nine
+        0x00001800007e001eULL, // 21:10 it is ten minutes past nine
+        0x0000180000600786ULL, // 21:15 it is quarter past nine
+        0x00001800007e7806ULL, // 21:20 it is twenty minutes past nine
+        0x00001800007ff806ULL, // 21:25 it is twenty five minutes past nine
+        0x0000180000600066ULL, // 21:30 it is half past nine
+        0x00006000009ff806ULL, // 21:35 it is twenty five minutes to ten
+        0x00006000009e7806ULL, // 21:40 it is twenty minutes to ten
+        0x0000600000800786ULL, // 21:45 it is quarter to ten
+        0x00006000009e001eULL, // 21:50 it is ten minutes to ten
+        0x00006000009f8006ULL, // 21:55 it is five minutes to ten
+    },
+    {
+        0x03c0600000000006ULL, // 22:00 it is ten oclock
+        0x00006000007f8006ULL, // 22:05 it is five minutes past ten
+        0x00006000007e001eULL, // 22:10 it is ten minutes past ten
+        0x0000600000600786ULL, // 22:15 it is quarter past ten
+        0x00006000007e7806ULL, // 22:20 it is twenty minutes past ten
+        0x00006000007ff806ULL, // 22:25 it is twenty five minutes past ten
+        0x0000600000600066ULL, // 22:30 it is half past ten
+        0x00078000009ff806ULL, // 22:35 it is twenty five minutes to eleven
+        0x00078000009e7806ULL, // 22:40 it is twenty minutes to eleven
+        0x0007800000800786ULL, // 22:45 it is quarter to eleven
+        0x00078000009e001eULL, // 22:50 it is ten minutes to eleven
+        0x00078000009f8006ULL, // 22:55 it is five minutes to eleven
+    },
+    {
+        0x03c7800000000006ULL, // 23:00 it is eleven oclock
+        0x00078000007f8006ULL, // 23:05 it is five minutes past eleven
+        0x00078000007e001eULL, // 23:10 it is ten minutes past eleven
+        0x0007800000600786ULL, // 23:15 it is quarter past eleven
+        0x00078000007e7806ULL, // 23:20 it is twenty minutes past eleven
+        0x00078000007ff806ULL, // 23:25 it is twenty five minutes past eleven
+        0x0007800000600066ULL, // 23:30 it is half past eleven
+        0x00380000009ff806ULL, // 23:35 it is twenty five minutes to twelve
+        0x00380000009e7806ULL, // 23:40 it is twenty minutes to twelve
+        0x0038000000800786ULL, // 23:45 it is quarter to twelve
+        0x00380000009e001eULL, // 23:50 it is ten minutes to twelve
+        0x00380000009f8006ULL, // 23:55 it is five minutes to twelve
+    },
+};
+
+#endif // TIME_GOLDEN_H
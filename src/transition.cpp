@@ -0,0 +1,46 @@
+/**
+ * @file transition.cpp
+ * @brief Implementation of the time-based word crossfade.
+ */
+
+#include "transition.h"
+
+void MaskTransition::setTarget(LedMask mask, uint32_t now) {
+    if (mask == toMask) {
+        return;
+    }
+    fromMask = toMask;
+    toMask = mask;
+    startTime = now;
+}
+
+uint8_t MaskTransition::progress(uint32_t now) const {
+    uint32_t elapsed = now - startTime;
+    if (elapsed >= durationMs) {
+        return 255;
+    }
+    uint8_t linear = (elapsed * 255) / durationMs;
+    switch (easing) {
+        case EASE_IN_OUT_QUAD:
+            return ease8InOutQuad(linear);
+        case EASE_IN_OUT_CUBIC:
+            return ease8InOutCubic(linear);
+        case EASE_LINEAR:
+        default:
+            return linear;
+    }
+}
+
+void MaskTransition::render(const CRGB* colors, CRGB* ledArray, uint32_t now) const {
+    uint8_t amount = progress(now);
+    for (uint8_t i = 0; i < NUM_LEDS; i++) {
+        LedMask bit = 1ULL << i;
+        CRGB incoming = (toMask & bit) ? colors[i] : CRGB(CRGB::Black);
+        if (amount == 255) {
+            ledArray[i] = incoming;
+            continue;
+        }
+        ledArray[i] = (fromMask & bit) ? colors[i] : CRGB(CRGB::Black);
+        nblend(ledArray[i], incoming, amount);
+    }
+}
@@ -0,0 +1,74 @@
+/**
+ * @file transition.h
+ * @brief Time-based crossfade between two sets of lit LEDs.
+ *
+ * When the sentence changes, the previous and next word masks are kept and
+ * blended by elapsed time rather than by frame count, so a late or skipped
+ * frame does not change how the transition looks.
+ */
+#ifndef TRANSITION_H
+#define TRANSITION_H
+
+#include <FastLED.h>
+#include "config.h"
+#include "word_layout.h"
+
+// Easing curves for the crossfade.
+enum TransitionEasing {
+    EASE_LINEAR,
+    EASE_IN_OUT_QUAD,
+    EASE_IN_OUT_CUBIC,
+};
+
+class MaskTransition {
+public:
+    MaskTransition(uint16_t durationMs = TRANSITION_DURATION_MS, TransitionEasing easing = TRANSITION_EASING)
+        : durationMs(durationMs), easing(easing) {}
+
+    /**
+     * @brief Sets the LEDs that should be lit, starting a crossfade if they changed.
+     * @param mask The LEDs to fade in.
+     * @param now Current time in ms.
+     */
+    void setTarget(LedMask mask, uint32_t now);
+
+    /**
+     * @brief Forgets what is on screen, so the next target fades in from black.
+     */
+    void clear() { fromMask = 0; toMask = 0; }
+
+    /**
+     * @brief Returns the eased progress of the current crossfade, 0 to 255.
+     * @param now Current time in ms.
+     */
+    uint8_t progress(uint32_t now) const;
+
+    /**
+     * @brief Returns true while a crossfade is in progress.
+     * @param now Current time in ms.
+     */
+    bool active(uint32_t now) const { return now - startTime < durationMs && fromMask != toMask; }
+
+    LedMask from() const { return fromMask; }
+    LedMask to() const { return toMask; }
+
+    /**
+     * @brief Blends the outgoing and incoming LEDs into the LED array.
+     *
+     * LEDs outside both masks are turned off.
+     * @param colors Scheme colors for every LED in to(), and in from() while active().
+     * @param ledArray Pointer to the CRGB LED array.
+     * @param now Current time in ms.
+     */
+    void render(const CRGB* colors, CRGB* ledArray, uint32_t now) const;
+
+    uint16_t durationMs;
+    TransitionEasing easing;
+
+private:
+    LedMask fromMask = 0;
+    LedMask toMask = 0;
+    uint32_t startTime = 0;
+};
+
+#endif // TRANSITION_H
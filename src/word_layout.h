@@ -1,6 +1,9 @@
 /**
  * @file word_layout.h
  * @brief Defines the structure and layout of words on the clock face.
+ *
+ * The layout is a single constexpr table, so it lives in flash and per-LED
+ * lookup tables can be derived from it at compile time.
  */
 
 #ifndef WORD_LAYOUT_H
@@ -8,42 +11,90 @@
 
 #include <stdint.h>
 
+// Identifies each word on the clock face; also its index in clockWords.
+enum WordId : uint8_t {
+    WORD_IT,
+    WORD_IS,
+    WORD_TEN_MIN,
+    WORD_HALF,
+    WORD_QUARTER,
+    WORD_TWENTY,
+    WORD_FIVE_MIN,
+    WORD_MINUTES,
+    WORD_PAST,
+    WORD_TO,
+    WORD_ONE, // ONE through TWELVE must stay in order
+    WORD_TWO,
+    WORD_THREE,
+    WORD_FOUR,
+    WORD_FIVE,
+    WORD_SIX,
+    WORD_SEVEN,
+    WORD_EIGHT,
+    WORD_NINE,
+    WORD_TEN,
+    WORD_ELEVEN,
+    WORD_TWELVE,
+    WORD_OCLOCK,
+    WORD_COUNT // Helper to get the count of words
+};
+
 // Represents a single word on the clock face
 struct Word {
     uint8_t startIndex; // The index of the first LED for this word
     uint8_t wordLength; // How many LEDs are in this word
     uint8_t x;          // X-coordinate on the grid (for animations)
     uint8_t y;          // Y-coordinate on the grid (for animations)
-    String word;
+    const char* name;   // For debug output only
+};
+
+// Every word on the clock face, indexed by WordId.
+// Grid is 13 letters wide and 8 rows tall, origin in lower left.
+inline constexpr Word clockWords[WORD_COUNT] = {
+    {1,  1, 0, 7, "it"},
+    {2,  1, 3, 7, "is"},
+    {3,  2, 6, 7, "ten"},     // TEN (minutes)
+    {5,  2, 9, 7, "half"},
+    {7,  4, 0, 6, "quarter"},
+    {11, 4, 7, 6, "twenty"},
+    {15, 2, 0, 5, "five"},    // FIVE (minutes)
+    {17, 4, 5, 5, "minutes"},
+    {21, 2, 0, 4, "past"},
+    {23, 1, 4, 4, "to"},
+    {24, 2, 7, 4, "one"},
+    {26, 2, 10,4, "two"},
+    {28, 3, 0, 3, "three"},
+    {31, 2, 5, 3, "four"},
+    {33, 2, 9, 3, "five"},
+    {35, 2, 0, 2, "six"},
+    {37, 3, 3, 2, "seven"},
+    {40, 3, 8, 2, "eight"},
+    {43, 2, 0, 1, "nine"},
+    {45, 2, 4, 1, "ten"},
+    {47, 4, 7, 1, "eleven"},
+    {51, 3, 0, 0, "twelve"},
+    {54, 4, 5, 0, "oclock"}
 };
 
-// Extern declarations make these variables available to other files.
-// The actual data is defined in word_layout.cpp.
-extern const Word* W_IT;
-extern const Word* W_IS;
-extern const Word* W_TEN_MIN;
-extern const Word* W_HALF;
-extern const Word* W_QUARTER;
-extern const Word* W_TWENTY;
-extern const Word* W_FIVE_MIN;
-extern const Word* W_MINUTES;
-extern const Word* W_PAST;
-extern const Word* W_TO;
-extern const Word* W_ONE;
-extern const Word* W_TWO;
-extern const Word* W_THREE;
-extern const Word* W_FOUR;
-extern const Word* W_FIVE;
-extern const Word* W_SIX;
-extern const Word* W_SEVEN;
-extern const Word* W_EIGHT;
-extern const Word* W_NINE;
-extern const Word* W_TEN;
-extern const Word* W_ELEVEN;
-extern const Word* W_TWELVE;
-extern const Word* W_OCLOCK;
-
-extern const Word clockWords[];
-extern const uint8_t numWords;
+// One bit per LED; bit n set means LED n is lit.
+typedef uint64_t LedMask;
+
+// The LEDs covered by a single word.
+constexpr LedMask wordMask(const Word& w) {
+    return ((1ULL << w.wordLength) - 1) << w.startIndex;
+}
+
+constexpr LedMask wordMask(WordId id) {
+    return wordMask(clockWords[id]);
+}
+
+// Calls fn(ledIndex) for every LED set in the mask, lowest index first.
+template <typename Fn>
+inline void forEachLed(LedMask mask, Fn fn) {
+    while (mask) {
+        fn((uint8_t)__builtin_ctzll(mask));
+        mask &= mask - 1;
+    }
+}
 
 #endif // WORD_LAYOUT_H
@@ -0,0 +1,107 @@
+/**
+ * @file Adafruit_GFX.h
+ * @brief Stand-in for Adafruit_GFX in the native (host) build.
+ *
+ * GFXcanvas1 keeps a real 1 bpp buffer with Adafruit's bit layout. Text is
+ * not rasterized with the font: each character draws a 5x7 pattern made from
+ * its code, so different text still gives different pixels.
+ */
+#ifndef HOST_ADAFRUIT_GFX_H
+#define HOST_ADAFRUIT_GFX_H
+
+#include "Arduino.h"
+#include <vector>
+
+struct GFXfont {
+    const uint8_t* bitmap;
+    const void* glyph;
+    uint16_t first;
+    uint16_t last;
+    uint8_t yAdvance;
+};
+
+class Adafruit_GFX : public Print {
+public:
+    Adafruit_GFX(int16_t w, int16_t h) : _width(w), _height(h) {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        for (int16_t j = y; j < y + h; j++) {
+            for (int16_t i = x; i < x + w; i++) {
+                drawPixel(i, j, color);
+            }
+        }
+    }
+
+    virtual void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+
+    void drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg) {
+        int16_t byteWidth = (w + 7) / 8;
+        for (int16_t j = 0; j < h; j++) {
+            for (int16_t i = 0; i < w; i++) {
+                bool set = bitmap[j * byteWidth + i / 8] & (0x80 >> (i & 7));
+                drawPixel(x + i, y + j, set ? color : bg);
+            }
+        }
+    }
+
+    size_t write(uint8_t c) override {
+        if (c == '\n') {
+            cursorX = 0;
+            return 1;
+        }
+        for (int16_t row = 0; row < 7; row++) {
+            for (int16_t col = 0; col < 5; col++) {
+                if ((c >> ((row + col) % 7)) & 1) {
+                    drawPixel(cursorX + col, cursorY - 7 + row, textColor);
+                }
+            }
+        }
+        cursorX += 6;
+        return 1;
+    }
+    using Print::write;
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+    void setCursor(int16_t x, int16_t y) { cursorX = x; cursorY = y; }
+    void setTextColor(uint16_t color) { textColor = color; }
+    void setTextSize(uint8_t) {}
+    void setTextWrap(bool) {}
+    void setFont(const GFXfont*) {}
+    void setRotation(uint8_t r) { rotation = r; }
+    uint8_t getRotation() const { return rotation; }
+
+protected:
+    int16_t _width;
+    int16_t _height;
+    int16_t cursorX = 0;
+    int16_t cursorY = 0;
+    uint16_t textColor = 1;
+    uint8_t rotation = 0;
+};
+
+class GFXcanvas1 : public Adafruit_GFX {
+public:
+    GFXcanvas1(uint16_t w, uint16_t h) : Adafruit_GFX(w, h), buffer(((w + 7) / 8) * h) {}
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if (x < 0 || y < 0 || x >= _width || y >= _height) {
+            return;
+        }
+        uint8_t& byte = buffer[y * ((_width + 7) / 8) + x / 8];
+        byte = color ? (byte | (0x80 >> (x & 7))) : (byte & ~(0x80 >> (x & 7)));
+    }
+
+    bool getPixel(int16_t x, int16_t y) const {
+        return buffer[y * ((_width + 7) / 8) + x / 8] & (0x80 >> (x & 7));
+    }
+
+    uint8_t* getBuffer() const { return const_cast<uint8_t*>(buffer.data()); }
+
+private:
+    std::vector<uint8_t> buffer;
+};
+
+#endif // HOST_ADAFRUIT_GFX_H
@@ -0,0 +1,47 @@
+/**
+ * @file Adafruit_ThinkInk.h
+ * @brief Fake SSD1680 e-paper driver for the native (host) build.
+ *
+ * Draws into a 1 bpp buffer and counts refreshes instead of driving a panel.
+ */
+#ifndef HOST_ADAFRUIT_THINKINK_H
+#define HOST_ADAFRUIT_THINKINK_H
+
+#include "Adafruit_GFX.h"
+
+#define EPD_WHITE 0
+#define EPD_BLACK 1
+
+struct SPIClass {};
+inline SPIClass SPI;
+
+class Adafruit_EPD : public GFXcanvas1 {
+public:
+    Adafruit_EPD(int w, int h, int8_t busyPin) : GFXcanvas1(w, h), _busy_pin(busyPin) {}
+    virtual ~Adafruit_EPD() = default;
+
+    void begin(bool = true) {}
+    void clearBuffer() { fillScreen(EPD_WHITE); }
+    void powerUp() { busy_wait(); }
+    void powerDown() {}
+    void display(bool = false) { fullRefreshes++; busy_wait(); }
+    void displayPartial(uint16_t, uint16_t, uint16_t, uint16_t) { partialRefreshes++; busy_wait(); }
+
+    uint32_t fullRefreshes = 0;
+    uint32_t partialRefreshes = 0;
+
+protected:
+    virtual void busy_wait() {}
+    int8_t _busy_pin;
+};
+
+class Adafruit_SSD1680 : public Adafruit_EPD {
+public:
+    Adafruit_SSD1680(int width, int height, int8_t, int8_t, int8_t, int8_t, int8_t busy, SPIClass*)
+        : Adafruit_EPD(width, height, busy) {}
+
+protected:
+    void busy_wait() override {}
+};
+
+#endif // HOST_ADAFRUIT_THINKINK_H
@@ -0,0 +1,152 @@
+/**
+ * @file Arduino.h
+ * @brief Stand-in for the Arduino core in the native (host) build.
+ *
+ * Only what the sources built for env:native use. Time comes from the
+ * virtual clock in host_clock.h; Serial writes to stdout.
+ */
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include "host_clock.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/event_groups.h"
+
+#define IRAM_ATTR
+#define INPUT        0x01
+#define INPUT_PULLUP 0x05
+#define OUTPUT       0x03
+#define LOW          0
+#define HIGH         1
+#define FALLING      2
+#define RISING       1
+
+using std::max;
+using std::min;
+
+// --- Time ---
+
+inline unsigned long millis() { return host::nowUs() / 1000; }
+inline unsigned long micros() { return host::nowUs(); }
+inline void delay(uint32_t ms) { host::advance(host::nowUs() + (uint64_t)ms * 1000); }
+
+// --- Math and random numbers ---
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+namespace host {
+inline uint32_t randomState = 1;
+}
+
+inline long random(long howBig) {
+    if (howBig <= 0) {
+        return 0;
+    }
+    host::randomState = host::randomState * 1103515245 + 12345;
+    return (host::randomState >> 8) % howBig;
+}
+
+inline long random(long howSmall, long howBig) {
+    return howSmall >= howBig ? howSmall : howSmall + random(howBig - howSmall);
+}
+
+inline void randomSeed(unsigned long seed) { host::randomState = seed ? seed : 1; }
+
+// --- GPIO, no hardware behind it ---
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline void attachInterrupt(uint8_t, void (*)(), int) {}
+inline void attachInterruptArg(uint8_t, void (*)(void*), void*, int) {}
+inline void detachInterrupt(uint8_t) {}
+
+// --- Print and Serial ---
+
+class Print {
+public:
+    virtual ~Print() = default;
+    virtual size_t write(uint8_t c) = 0;
+
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+        while (size--) {
+            n += write(*buffer++);
+        }
+        return n;
+    }
+
+    size_t write(const char* text) { return write((const uint8_t*)text, strlen(text)); }
+    size_t print(const char* text) { return write(text); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(long value) { return printf("%ld", value); }
+    size_t print(unsigned long value) { return printf("%lu", value); }
+    size_t print(int value) { return print((long)value); }
+    size_t print(unsigned int value) { return print((unsigned long)value); }
+    size_t println() { return write("\r\n"); }
+
+    template <typename T>
+    size_t println(T value) {
+        size_t n = print(value);
+        return n + println();
+    }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        char line[256];
+        va_list args;
+        va_start(args, format);
+        int length = vsnprintf(line, sizeof(line), format, args);
+        va_end(args);
+        if (length < 0) {
+            return 0;
+        }
+        return write((const uint8_t*)line, std::min((size_t)length, sizeof(line) - 1));
+    }
+};
+
+// Print to a stdio stream, e.g. for frame dumps.
+class FilePrint : public Print {
+public:
+    explicit FilePrint(FILE* file) : file(file) {}
+    size_t write(uint8_t c) override { return fputc(c, file) == EOF ? 0 : 1; }
+    size_t write(const uint8_t* buffer, size_t size) override { return fwrite(buffer, 1, size, file); }
+    using Print::write;
+
+private:
+    FILE* file;
+};
+
+class HardwareSerial : public FilePrint {
+public:
+    HardwareSerial() : FilePrint(stdout) {}
+    void begin(unsigned long) {}
+    int available() { return 0; }
+    int read() { return -1; }
+};
+
+inline HardwareSerial Serial;
+
+// --- ESP32 specifics ---
+
+struct EspClass {
+    uint32_t getFreeHeap() { return 0; } // Use the allocation counters of the host tests instead
+    uint32_t getCycleCount() { return micros() * 240; }
+};
+
+inline EspClass ESP;
+
+inline uint32_t getCpuFrequencyMhz() { return 240; }
+inline uint32_t esp_random() { return random(0x7FFFFFFF); }
+
+#endif // HOST_ARDUINO_H
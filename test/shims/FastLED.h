@@ -0,0 +1,317 @@
+/**
+ * @file FastLED.h
+ * @brief Stand-in for the FastLED color types in the native (host) build.
+ *
+ * Follows FastLED's 8-bit math (scale8, blend8, the rainbow HSV conversion
+ * and palette interpolation) closely enough that frames rendered on the
+ * host look like the ones on the strip. inoise16 is plain Perlin noise,
+ * not FastLED's exact fixed-point version. FastLED.show() only counts.
+ */
+#ifndef HOST_FASTLED_H
+#define HOST_FASTLED_H
+
+#include "Arduino.h"
+#include <functional>
+
+typedef uint8_t fract8;
+
+// --- 8-bit math ---
+
+inline uint8_t scale8(uint8_t i, fract8 scale) { return ((uint16_t)i * (1 + (uint16_t)scale)) >> 8; }
+
+inline uint8_t scale8_video(uint8_t i, fract8 scale) {
+    return (((int)i * (int)scale) >> 8) + ((i && scale) ? 1 : 0);
+}
+
+inline uint8_t qadd8(uint8_t i, uint8_t j) {
+    unsigned int t = i + j;
+    return t > 255 ? 255 : t;
+}
+
+inline uint8_t blend8(uint8_t a, uint8_t b, uint8_t amountOfB) {
+    uint16_t partial = (a << 8) | b;
+    partial += b * amountOfB;
+    partial -= a * amountOfB;
+    return partial >> 8;
+}
+
+inline uint8_t lerp8by8(uint8_t a, uint8_t b, fract8 frac) {
+    return b > a ? a + scale8(b - a, frac) : a - scale8(a - b, frac);
+}
+
+inline uint8_t ease8InOutQuad(uint8_t i) {
+    uint8_t j = (i & 0x80) ? 255 - i : i;
+    uint8_t jj2 = scale8(j, j) << 1;
+    return (i & 0x80) ? 255 - jj2 : jj2;
+}
+
+inline uint8_t ease8InOutCubic(uint8_t i) {
+    uint8_t ii = scale8(i, i);
+    uint8_t iii = scale8(ii, i);
+    uint16_t r1 = (3 * (uint16_t)ii) - (2 * (uint16_t)iii);
+    return (r1 & 0x100) ? 255 : r1;
+}
+
+namespace host {
+inline uint16_t random16Seed = 1337;
+}
+
+inline uint8_t random8() {
+    host::random16Seed = host::random16Seed * 2053 + 13849;
+    return (uint8_t)((host::random16Seed & 0xFF) + (host::random16Seed >> 8));
+}
+
+inline uint8_t random8(uint8_t lim) { return ((uint16_t)random8() * lim) >> 8; }
+inline void random16_set_seed(uint16_t seed) { host::random16Seed = seed; }
+
+// --- Colors ---
+
+struct CHSV {
+    uint8_t hue = 0;
+    uint8_t sat = 0;
+    uint8_t val = 0;
+
+    CHSV() = default;
+    constexpr CHSV(uint8_t h, uint8_t s, uint8_t v) : hue(h), sat(s), val(v) {}
+};
+
+struct CRGB;
+inline void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb);
+
+struct CRGB {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+
+    enum HTMLColorCode : uint32_t {
+        Black = 0x000000,
+        White = 0xFFFFFF,
+        Red = 0xFF0000,
+        Green = 0x008000,
+        Blue = 0x0000FF,
+    };
+
+    CRGB() = default;
+    constexpr CRGB(uint8_t r, uint8_t g, uint8_t b) : r(r), g(g), b(b) {}
+    constexpr CRGB(uint32_t colorcode) : r(colorcode >> 16), g(colorcode >> 8), b(colorcode) {}
+    constexpr CRGB(HTMLColorCode colorcode) : CRGB((uint32_t)colorcode) {}
+    CRGB(const CHSV& hsv) { hsv2rgb_rainbow(hsv, *this); }
+
+    CRGB& operator=(const CHSV& hsv) {
+        hsv2rgb_rainbow(hsv, *this);
+        return *this;
+    }
+
+    uint8_t& operator[](uint8_t x) { return x == 0 ? r : (x == 1 ? g : b); }
+    const uint8_t& operator[](uint8_t x) const { return x == 0 ? r : (x == 1 ? g : b); }
+
+    explicit operator bool() const { return r || g || b; }
+
+    CRGB& nscale8(uint8_t scale) {
+        r = scale8(r, scale);
+        g = scale8(g, scale);
+        b = scale8(b, scale);
+        return *this;
+    }
+
+    CRGB& fadeToBlackBy(uint8_t fadeFactor) { return nscale8(255 - fadeFactor); }
+};
+
+inline bool operator==(const CRGB& a, const CRGB& b) { return a.r == b.r && a.g == b.g && a.b == b.b; }
+inline bool operator!=(const CRGB& a, const CRGB& b) { return !(a == b); }
+
+// FastLED's "rainbow" hue mapping: yellow gets as much of the wheel as the other colors.
+inline void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb) {
+    uint8_t hue = hsv.hue;
+    uint8_t sat = hsv.sat;
+    uint8_t val = hsv.val;
+    uint8_t offset8 = (hue & 0x1F) << 3;
+    uint8_t third = scale8(offset8, 85);
+    uint8_t twothirds = scale8(offset8, 170);
+    uint8_t r, g, b;
+    switch (hue >> 5) {
+        case 0: r = 255 - third; g = third; b = 0; break;
+        case 1: r = 171; g = 85 + third; b = 0; break;
+        case 2: r = 171 - twothirds; g = 170 + third; b = 0; break;
+        case 3: r = 0; g = 255 - third; b = third; break;
+        case 4: r = 0; g = 171 - twothirds; b = 85 + twothirds; break;
+        case 5: r = third; g = 0; b = 255 - third; break;
+        case 6: r = 85 + third; g = 0; b = 171 - third; break;
+        default: r = 170 + third; g = 0; b = 85 - third; break;
+    }
+    if (sat != 255) {
+        if (sat == 0) {
+            r = g = b = 255;
+        } else {
+            uint8_t desat = scale8(255 - sat, 255 - sat);
+            uint8_t satscale = 255 - desat;
+            r = scale8(r, satscale) + desat;
+            g = scale8(g, satscale) + desat;
+            b = scale8(b, satscale) + desat;
+        }
+    }
+    if (val != 255) {
+        val = scale8_video(val, val);
+        r = scale8(r, val);
+        g = scale8(g, val);
+        b = scale8(b, val);
+    }
+    rgb = CRGB(r, g, b);
+}
+
+inline void fill_solid(CRGB* leds, int count, const CRGB& color) {
+    for (int i = 0; i < count; i++) {
+        leds[i] = color;
+    }
+}
+
+inline void fadeToBlackBy(CRGB* leds, uint16_t count, uint8_t fadeBy) {
+    for (uint16_t i = 0; i < count; i++) {
+        leds[i].fadeToBlackBy(fadeBy);
+    }
+}
+
+inline CRGB& nblend(CRGB& existing, const CRGB& overlay, fract8 amountOfOverlay) {
+    if (amountOfOverlay == 0) {
+        return existing;
+    }
+    if (amountOfOverlay == 255) {
+        existing = overlay;
+        return existing;
+    }
+    existing.r = blend8(existing.r, overlay.r, amountOfOverlay);
+    existing.g = blend8(existing.g, overlay.g, amountOfOverlay);
+    existing.b = blend8(existing.b, overlay.b, amountOfOverlay);
+    return existing;
+}
+
+// --- Palettes ---
+
+typedef uint32_t TProgmemRGBPalette16[16];
+
+inline constexpr TProgmemRGBPalette16 RainbowColors_p = {
+    0xFF0000, 0xD52A00, 0xAB5500, 0xAB7F00, 0xABAB00, 0x56D500, 0x00FF00, 0x00D52A,
+    0x00AB55, 0x0056AA, 0x0000FF, 0x2A00D5, 0x5500AB, 0x7F0081, 0xAB0055, 0xD5002B,
+};
+
+struct CRGBPalette16 {
+    CRGB entries[16];
+
+    CRGBPalette16() = default;
+    CRGBPalette16(const TProgmemRGBPalette16& rhs) {
+        for (uint8_t i = 0; i < 16; i++) {
+            entries[i] = CRGB(rhs[i]);
+        }
+    }
+
+    CRGB& operator[](uint8_t x) { return entries[x]; }
+    const CRGB& operator[](uint8_t x) const { return entries[x]; }
+};
+
+// Color at `index` of a 16-entry palette, blending linearly between entries.
+inline CRGB ColorFromPalette(const CRGBPalette16& pal, uint8_t index) {
+    uint8_t hi4 = index >> 4;
+    uint8_t lo4 = index & 0x0F;
+    const CRGB& entry = pal[hi4];
+    if (lo4 == 0) {
+        return entry;
+    }
+    const CRGB& next = pal[(hi4 + 1) & 0x0F];
+    uint8_t f2 = lo4 << 4;
+    uint8_t f1 = 255 - f2;
+    return CRGB(scale8(entry.r, f1) + scale8(next.r, f2), scale8(entry.g, f1) + scale8(next.g, f2),
+                scale8(entry.b, f1) + scale8(next.b, f2));
+}
+
+struct CRGBPalette256 {
+    CRGB entries[256];
+
+    CRGBPalette256() = default;
+    CRGBPalette256(const CRGBPalette16& rhs) { *this = rhs; }
+    CRGBPalette256(const TProgmemRGBPalette16& rhs) { *this = CRGBPalette16(rhs); }
+
+    CRGBPalette256& operator=(const CRGBPalette16& rhs) {
+        for (int i = 0; i < 256; i++) {
+            entries[i] = ColorFromPalette(rhs, i);
+        }
+        return *this;
+    }
+
+    CRGB& operator[](uint8_t x) { return entries[x]; }
+    const CRGB& operator[](uint8_t x) const { return entries[x]; }
+};
+
+// --- Noise ---
+
+namespace host {
+
+inline double noiseFade(double t) { return t * t * t * (t * (t * 6 - 15) + 10); }
+
+inline double noiseGrad(int hash, double x, double y, double z) {
+    int h = hash & 15;
+    double u = h < 8 ? x : y;
+    double v = h < 4 ? y : (h == 12 || h == 14 ? x : z);
+    return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
+}
+
+// Ken Perlin's improved noise, in -1..1.
+inline double perlin(double x, double y, double z) {
+    static const uint8_t p[256] = {
+        151, 160, 137, 91, 90, 15, 131, 13, 201, 95, 96, 53, 194, 233, 7, 225, 140, 36, 103, 30, 69, 142, 8, 99,
+        37, 240, 21, 10, 23, 190, 6, 148, 247, 120, 234, 75, 0, 26, 197, 62, 94, 252, 219, 203, 117, 35, 11, 32,
+        57, 177, 33, 88, 237, 149, 56, 87, 174, 20, 125, 136, 171, 168, 68, 175, 74, 165, 71, 134, 139, 48, 27,
+        166, 77, 146, 158, 231, 83, 111, 229, 122, 60, 211, 133, 230, 220, 105, 92, 41, 55, 46, 245, 40, 244, 102,
+        143, 54, 65, 25, 63, 161, 1, 216, 80, 73, 209, 76, 132, 187, 208, 89, 18, 169, 200, 196, 135, 130, 116,
+        188, 159, 86, 164, 100, 109, 198, 173, 186, 3, 64, 52, 217, 226, 250, 124, 123, 5, 202, 38, 147, 118, 126,
+        255, 82, 85, 212, 207, 206, 59, 227, 47, 16, 58, 17, 182, 189, 28, 42, 223, 183, 170, 213, 119, 248, 152,
+        2, 44, 154, 163, 70, 221, 153, 101, 155, 167, 43, 172, 9, 129, 22, 39, 253, 19, 98, 108, 110, 79, 113,
+        224, 232, 178, 185, 112, 104, 218, 246, 97, 228, 251, 34, 242, 193, 238, 210, 144, 12, 191, 179, 162,
+        241, 81, 51, 145, 235, 249, 14, 239, 107, 49, 192, 214, 31, 181, 199, 106, 157, 184, 84, 204, 176, 115,
+        121, 50, 45, 127, 4, 150, 254, 138, 236, 205, 93, 222, 114, 67, 29, 24, 72, 243, 141, 128, 195, 78, 66,
+        215, 61, 156, 180,
+    };
+    auto perm = [](int i) { return p[i & 255]; };
+    int xi = (int)floor(x), yi = (int)floor(y), zi = (int)floor(z);
+    x -= xi;
+    y -= yi;
+    z -= zi;
+    double u = noiseFade(x), v = noiseFade(y), w = noiseFade(z);
+    int a = perm(xi) + yi, aa = perm(a) + zi, ab = perm(a + 1) + zi;
+    int b = perm(xi + 1) + yi, ba = perm(b) + zi, bb = perm(b + 1) + zi;
+    auto lerp = [](double t, double a, double b) { return a + t * (b - a); };
+    return lerp(w,
+                lerp(v, lerp(u, noiseGrad(perm(aa), x, y, z), noiseGrad(perm(ba), x - 1, y, z)),
+                     lerp(u, noiseGrad(perm(ab), x, y - 1, z), noiseGrad(perm(bb), x - 1, y - 1, z))),
+                lerp(v, lerp(u, noiseGrad(perm(aa + 1), x, y, z - 1), noiseGrad(perm(ba + 1), x - 1, y, z - 1)),
+                     lerp(u, noiseGrad(perm(ab + 1), x, y - 1, z - 1), noiseGrad(perm(bb + 1), x - 1, y - 1, z - 1))));
+}
+
+} // namespace host
+
+// 3D noise over 16.16 fixed-point coordinates, like FastLED's: 0 to 65535, centered on 32768.
+inline uint16_t inoise16(uint32_t x, uint32_t y, uint32_t z) {
+    double n = host::perlin(x / 65536.0, y / 65536.0, z / 65536.0);
+    return (uint16_t)std::min(65535.0, std::max(0.0, (n + 1) * 32767.5));
+}
+
+// --- Output ---
+
+// Counts show() calls; tests can hook in to see each frame sent to the strip.
+class CFastLED {
+public:
+    void show() {
+        shows++;
+        if (onShow) {
+            onShow();
+        }
+    }
+    void setBrightness(uint8_t value) { brightness = value; }
+
+    uint32_t shows = 0;
+    uint8_t brightness = 255;
+    std::function<void()> onShow;
+};
+
+inline CFastLED FastLED;
+
+#endif // HOST_FASTLED_H
@@ -0,0 +1,52 @@
+/**
+ * @file Preferences.h
+ * @brief In-memory stand-in for the ESP32 NVS Preferences in the native (host) build.
+ */
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+
+class Preferences {
+public:
+    bool begin(const char*, bool = false) { return true; }
+    void end() {}
+    bool clear() { values.clear(); return true; }
+    bool remove(const char* key) { return values.erase(key) > 0; }
+    bool isKey(const char* key) { return values.count(key) > 0; }
+
+    size_t putBytes(const char* key, const void* value, size_t length) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(value);
+        values[key].assign(bytes, bytes + length);
+        return length;
+    }
+
+    size_t getBytesLength(const char* key) { return isKey(key) ? values[key].size() : 0; }
+
+    size_t getBytes(const char* key, void* buffer, size_t length) {
+        if (!isKey(key) || values[key].size() > length) {
+            return 0;
+        }
+        memcpy(buffer, values[key].data(), values[key].size());
+        return values[key].size();
+    }
+
+    size_t putUInt(const char* key, uint32_t value) { return putBytes(key, &value, sizeof(value)); }
+
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0) {
+        uint32_t value = defaultValue;
+        return getBytesLength(key) == sizeof(value) && getBytes(key, &value, sizeof(value)) ? value : defaultValue;
+    }
+
+    size_t putString(const char* key, const char* value) { return putBytes(key, value, strlen(value) + 1); }
+
+    size_t getString(const char* key, char* value, size_t maxLength) { return getBytes(key, value, maxLength); }
+
+private:
+    std::map<std::string, std::vector<uint8_t>> values;
+};
+
+#endif // HOST_PREFERENCES_H
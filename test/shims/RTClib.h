@@ -0,0 +1,53 @@
+/**
+ * @file RTClib.h
+ * @brief Fake DS3231 for the native (host) build.
+ *
+ * Keeps time as an offset from the virtual clock, running `ppm` fast or
+ * slow, so tests can let it drift against the system time.
+ */
+#ifndef HOST_RTCLIB_H
+#define HOST_RTCLIB_H
+
+#include "Arduino.h"
+
+class DateTime {
+public:
+    DateTime(uint32_t t = 0) : unixTime(t) {}
+    uint32_t unixtime() const { return unixTime; }
+    uint8_t second() const { return unixTime % 60; }
+    uint8_t minute() const { return (unixTime / 60) % 60; }
+    uint8_t hour() const { return (unixTime / 3600) % 24; }
+
+private:
+    uint32_t unixTime;
+};
+
+enum Ds3231SqwPinMode { DS3231_OFF = 0x1C, DS3231_SquareWave1Hz = 0x00 };
+
+class RTC_DS3231 {
+public:
+    bool begin() { return present; }
+    bool lostPower() { return powerLost; }
+    void writeSqwPinMode(Ds3231SqwPinMode) {}
+
+    void adjust(const DateTime& dt) {
+        setAtUs = host::nowUs();
+        setTo = dt.unixtime();
+        powerLost = false;
+    }
+
+    DateTime now() {
+        double elapsed = (host::nowUs() - setAtUs) / 1e6;
+        return DateTime(setTo + (uint32_t)(elapsed * (1 + ppm / 1e6)));
+    }
+
+    bool present = true;
+    bool powerLost = false;
+    double ppm = 0; // How fast the fake crystal runs
+
+private:
+    uint64_t setAtUs = 0;
+    uint32_t setTo = 0;
+};
+
+#endif // HOST_RTCLIB_H
@@ -0,0 +1,10 @@
+/**
+ * @file TimeLib.h
+ * @brief Empty stand-in for the Time library in the native (host) build; nothing built there uses it.
+ */
+#ifndef HOST_TIMELIB_H
+#define HOST_TIMELIB_H
+
+#include <time.h>
+
+#endif // HOST_TIMELIB_H
@@ -0,0 +1,12 @@
+/**
+ * @file FreeSans9pt7b.h
+ * @brief Empty font for the native (host) build, where text is not rasterized.
+ */
+#ifndef HOST_FREESANS9PT7B_H
+#define HOST_FREESANS9PT7B_H
+
+#include "../Adafruit_GFX.h"
+
+inline const GFXfont FreeSans9pt7b = {nullptr, nullptr, 0x20, 0x7E, 22};
+
+#endif // HOST_FREESANS9PT7B_H
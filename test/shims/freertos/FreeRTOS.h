@@ -0,0 +1,40 @@
+/**
+ * @file FreeRTOS.h
+ * @brief FreeRTOS types for the native (host) build, with a 1 ms tick as on the ESP32.
+ */
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+#include "../host_clock.h"
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE 0
+#define pdTRUE  1
+#define pdFAIL  0
+#define pdPASS  1
+#define errQUEUE_FULL 0
+#define portMAX_DELAY 0xFFFFFFFFUL
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portYIELD_FROM_ISR() do {} while (0)
+
+// Only one task runs on the host, so critical sections have nothing to exclude
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define taskENTER_CRITICAL(mux) do { (void)(mux); } while (0)
+#define taskEXIT_CRITICAL(mux) do { (void)(mux); } while (0)
+
+namespace host {
+
+// Deadline for a block of the given number of ticks, UINT64_MAX for portMAX_DELAY.
+inline uint64_t deadlineAfter(TickType_t ticks) {
+    return ticks == portMAX_DELAY ? UINT64_MAX : nowUs() + (uint64_t)ticks * 1000 * portTICK_PERIOD_MS;
+}
+
+} // namespace host
+
+#endif // HOST_FREERTOS_H
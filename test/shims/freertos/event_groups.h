@@ -0,0 +1,49 @@
+/**
+ * @file event_groups.h
+ * @brief FreeRTOS event groups for the native (host) build.
+ */
+#ifndef HOST_FREERTOS_EVENT_GROUPS_H
+#define HOST_FREERTOS_EVENT_GROUPS_H
+
+#include "FreeRTOS.h"
+
+typedef uint32_t EventBits_t;
+
+namespace host {
+
+struct EventGroup {
+    EventBits_t bits = 0;
+};
+
+} // namespace host
+
+typedef host::EventGroup* EventGroupHandle_t;
+
+inline EventGroupHandle_t xEventGroupCreate() { return new host::EventGroup; }
+
+inline EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits) {
+    return group->bits |= bits;
+}
+
+inline EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits) {
+    EventBits_t before = group->bits;
+    group->bits &= ~bits;
+    return before;
+}
+
+inline EventBits_t xEventGroupGetBits(EventGroupHandle_t group) { return group->bits; }
+
+inline EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t bits, BaseType_t clearOnExit,
+                                       BaseType_t waitForAll, TickType_t ticks) {
+    auto ready = [group, bits, waitForAll] {
+        return waitForAll ? (group->bits & bits) == bits : (group->bits & bits) != 0;
+    };
+    host::advance(host::deadlineAfter(ticks), ready);
+    EventBits_t result = group->bits;
+    if (ready() && clearOnExit) {
+        group->bits &= ~bits;
+    }
+    return result;
+}
+
+#endif // HOST_FREERTOS_EVENT_GROUPS_H
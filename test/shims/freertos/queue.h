@@ -0,0 +1,66 @@
+/**
+ * @file queue.h
+ * @brief FreeRTOS queues for the native (host) build.
+ *
+ * A receive that finds the queue empty lets the virtual clock run until an
+ * event (see host::at()) sends something, or the timeout passes. A send to
+ * a full queue fails at once: nothing could empty it while the only task
+ * waits.
+ */
+#ifndef HOST_FREERTOS_QUEUE_H
+#define HOST_FREERTOS_QUEUE_H
+
+#include <string.h>
+#include <deque>
+#include <vector>
+#include "FreeRTOS.h"
+
+namespace host {
+
+struct Queue {
+    size_t itemSize;
+    size_t length;
+    std::deque<std::vector<uint8_t>> items;
+};
+
+} // namespace host
+
+typedef host::Queue* QueueHandle_t;
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    return new host::Queue{itemSize, length, {}};
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t) {
+    if (queue->items.size() >= queue->length) {
+        return errQUEUE_FULL;
+    }
+    const uint8_t* bytes = static_cast<const uint8_t*>(item);
+    queue->items.emplace_back(bytes, bytes + queue->itemSize);
+    return pdPASS;
+}
+
+inline BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* woken) {
+    if (woken) {
+        *woken = pdFALSE;
+    }
+    return xQueueSend(queue, item, 0);
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t queue, void* buffer, TickType_t ticks) {
+    if (queue->items.empty() && ticks != 0) {
+        host::advance(host::deadlineAfter(ticks), [queue] { return !queue->items.empty(); });
+    }
+    if (queue->items.empty()) {
+        return pdFAIL;
+    }
+    if (queue->itemSize) {
+        memcpy(buffer, queue->items.front().data(), queue->itemSize);
+    }
+    queue->items.pop_front();
+    return pdPASS;
+}
+
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) { return queue->items.size(); }
+
+#endif // HOST_FREERTOS_QUEUE_H
@@ -0,0 +1,44 @@
+/**
+ * @file task.h
+ * @brief FreeRTOS task calls for the native (host) build.
+ *
+ * There is only one task on the host: the one under test. Delays let the
+ * virtual clock run, and notifications are counted but never block past
+ * their timeout.
+ */
+#ifndef HOST_FREERTOS_TASK_H
+#define HOST_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+namespace host {
+inline uint32_t taskNotifications = 0;
+}
+
+inline void vTaskDelay(TickType_t ticks) { host::advance(host::deadlineAfter(ticks)); }
+inline TickType_t xTaskGetTickCount() { return host::nowUs() / 1000 / portTICK_PERIOD_MS; }
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return &host::taskNotifications; }
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char*, uint32_t, void*, UBaseType_t,
+                                          TaskHandle_t*, BaseType_t) {
+    return pdFAIL; // Host tests call task functions directly
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+    host::advance(host::deadlineAfter(ticks), [] { return host::taskNotifications > 0; });
+    uint32_t count = host::taskNotifications;
+    host::taskNotifications = clearOnExit ? 0 : (count ? count - 1 : 0);
+    return count;
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t) {
+    host::taskNotifications++;
+    return pdPASS;
+}
+
+inline void vTaskNotifyGiveFromISR(TaskHandle_t, BaseType_t*) { host::taskNotifications++; }
+
+#endif // HOST_FREERTOS_TASK_H
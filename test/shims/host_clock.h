@@ -0,0 +1,108 @@
+/**
+ * @file host_clock.h
+ * @brief Virtual time for the native (host) build.
+ *
+ * millis(), micros(), vTaskDelay() and the fake FreeRTOS queues all run on
+ * this clock instead of wall time. Time only moves when a task blocks, so a
+ * simulated day passes in as long as it takes to render its frames. Events
+ * scheduled with host::at() stand in for the other tasks and interrupts:
+ * they run when the clock reaches them, on the blocked task's thread.
+ */
+#ifndef HOST_CLOCK_H
+#define HOST_CLOCK_H
+
+#include <stdint.h>
+#include <sys/time.h>
+#include <functional>
+#include <map>
+
+namespace host {
+
+// Thrown out of a blocking call once the clock passes the end set with runUntil().
+struct SimulationEnd {};
+
+struct Timeline {
+    uint64_t nowUs = 0;
+    uint64_t endUs = UINT64_MAX;
+    int64_t epochUs = 0; // System time (gettimeofday) minus nowUs
+    std::multimap<uint64_t, std::function<void()>> events;
+};
+
+inline Timeline timeline;
+
+inline uint64_t nowUs() { return timeline.nowUs; }
+
+/**
+ * @brief Schedules a callback at an absolute virtual time.
+ * @param us Virtual time in microseconds; events at the same time run in order added.
+ * @param event The callback.
+ */
+inline void at(uint64_t us, std::function<void()> event) {
+    timeline.events.emplace(us, std::move(event));
+}
+
+/**
+ * @brief Lets time pass up to a deadline, running due events on the way.
+ *
+ * Returns early, at the time of the event, as soon as ready() is true after
+ * an event ran.
+ * @param deadlineUs Virtual time to stop at; UINT64_MAX to wait for ready() only.
+ * @param ready Condition the caller is blocked on.
+ * @return true if ready() became true before the deadline.
+ */
+inline bool advance(uint64_t deadlineUs, const std::function<bool()>& ready = nullptr) {
+    for (;;) {
+        if (ready && ready()) {
+            return true;
+        }
+        auto next = timeline.events.begin();
+        uint64_t nextUs = next == timeline.events.end() ? UINT64_MAX : next->first;
+        if (nextUs > deadlineUs) {
+            if (deadlineUs > timeline.endUs || deadlineUs == UINT64_MAX) {
+                timeline.nowUs = timeline.endUs;
+                throw SimulationEnd{};
+            }
+            timeline.nowUs = deadlineUs > timeline.nowUs ? deadlineUs : timeline.nowUs;
+            return false;
+        }
+        if (nextUs > timeline.endUs) {
+            timeline.nowUs = timeline.endUs;
+            throw SimulationEnd{};
+        }
+        std::function<void()> event = std::move(next->second);
+        timeline.events.erase(next);
+        timeline.nowUs = nextUs > timeline.nowUs ? nextUs : timeline.nowUs;
+        event();
+    }
+}
+
+/**
+ * @brief Sets the time at which blocking calls end the simulation.
+ * @param us Virtual time in microseconds.
+ */
+inline void runUntil(uint64_t us) { timeline.endUs = us; }
+
+/**
+ * @brief Forgets all events and starts again at virtual time 0.
+ * @param epochSeconds System time (seconds since 1970) at virtual time 0.
+ */
+inline void reset(int64_t epochSeconds = 0) {
+    timeline = Timeline{};
+    timeline.epochUs = epochSeconds * 1000000;
+}
+
+inline int getTimeOfDay(struct timeval* tv, void*) {
+    int64_t us = timeline.epochUs + (int64_t)timeline.nowUs;
+    tv->tv_sec = us / 1000000;
+    tv->tv_usec = us % 1000000;
+    return 0;
+}
+
+inline int setTimeOfDay(const struct timeval* tv, const void*) {
+    timeline.epochUs = (int64_t)tv->tv_sec * 1000000 + tv->tv_usec - (int64_t)timeline.nowUs;
+    return 0;
+}
+
+} // namespace host
+
+#endif // HOST_CLOCK_H
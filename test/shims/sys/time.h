@@ -0,0 +1,26 @@
+/**
+ * @file time.h
+ * @brief Routes gettimeofday()/settimeofday() to the virtual clock in the native (host) build.
+ *
+ * Defined in host_clock.h: the system time is host::timeline.epochUs plus
+ * the virtual time, so a simulation can start on any date and be stepped
+ * like an NTP sync would.
+ */
+#ifndef HOST_SYS_TIME_H
+#define HOST_SYS_TIME_H
+
+#include_next <sys/time.h>
+
+#ifdef __cplusplus
+extern "C++" {
+namespace host {
+inline int getTimeOfDay(struct timeval* tv, void* tz);
+inline int setTimeOfDay(const struct timeval* tv, const void* tz);
+} // namespace host
+}
+
+#define gettimeofday host::getTimeOfDay
+#define settimeofday host::setTimeOfDay
+#endif
+
+#endif // HOST_SYS_TIME_H
@@ -0,0 +1,297 @@
+/**
+ * @file test_main.cpp
+ * @brief Host simulation of the clock task: pio test -e native -f test_clock_sim -v
+ *
+ * Runs the real taskClockUpdate() for 36 simulated hours on the virtual clock,
+ * across the CET to CEST change. The other tasks are fakes driven by events on
+ * the same clock: boot posts START_CLOCK_DISPLAY, an hourly "SNTP sync" steps
+ * the system clock by a few hundred ms and redraws the e-paper status, the
+ * color scheme is cycled, and a fake EPD task feeds the requests through
+ * task_epd's own addEpdRequest() and planEpdRefresh(), with modelled panel
+ * times instead of a busy line.
+ *
+ * Every minute the words on the LEDs are checked against localtime_r(). At the
+ * end the queue latencies, frame timings and EPD counters are printed in the
+ * format of the console "stats" command. Virtual time does not pass while the
+ * task computes, so frame_render is 0; the host time per frame is printed instead.
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <Arduino.h>
+#include "AppContext.h"
+#include "color_schemes.h"
+#include "runtime_stats.h"
+#include "time_golden.h"
+#include "tasks/clock_task.h"
+
+#define SIM_START_UTC  1774699200 // 2026-03-28 12:00:00 UTC, 13 hours before CEST starts
+#define SIM_HOURS      36
+#define SIM_TZ         "CET-1CEST,M3.5.0,M10.5.0/3"
+#define TIME_OF_DAY    5          // Index of the REFRESH_STATIC scheme
+#define EPD_FULL_MS    3500       // Modelled panel time of a full refresh
+#define EPD_PARTIAL_MS 700        // Modelled panel time of a partial refresh
+
+static const uint64_t SECOND_US = 1000000;
+static const uint64_t MINUTE_US = 60 * SECOND_US;
+static const uint64_t HOUR_US = 60 * MINUTE_US;
+
+static AppContext context;
+
+// --- Results ---
+
+struct SimResults {
+    bool done = false;
+    uint64_t hostNs = 0;
+    uint32_t minuteChecks = 0;
+    uint32_t minuteMismatches = 0;
+    uint32_t staticWakeups = 0;   // Clock task wakeups while only the static scheme ran
+    uint32_t staticMinutes = 0;
+    uint32_t epdBatches = 0;      // Times the fake EPD task found requests
+    bool epdQueued = false;
+    uint64_t epdQueuedUs = 0;     // First present() not yet seen by the fake EPD task
+    TimingStats epdQueueLatency;  // present() to the start of the refresh
+};
+
+static SimResults results;
+
+// --- Fakes for the other tasks ---
+
+static void every(uint64_t firstUs, uint64_t periodUs, std::function<void()> event) {
+    host::at(firstUs, [=] {
+        event();
+        every(firstUs + periodUs, periodUs, event);
+    });
+}
+
+static void sendCommand(SystemCommandType type) {
+    SystemCommand cmd = {type};
+    sendSystemCommand(&context, cmd);
+}
+
+// Like showStatus() in the WiFi task.
+static void showStatus() {
+    if (!context.status_screen.dirty()) {
+        return;
+    }
+    if (!results.epdQueued) {
+        results.epdQueued = true;
+        results.epdQueuedUs = host::nowUs();
+    }
+    EpdUpdate update = context.status_screen.draw(context.epd_frames.back());
+    context.epd_frames.present(context.epdQueue, update);
+}
+
+// task_epd without the panel: collect what arrived within EPD_SETTLE_MS and
+// let planEpdRefresh() decide, then charge the modelled panel time.
+static void fakeEpdTask() {
+    if (uxQueueMessagesWaiting(context.epdQueue) == 0) {
+        return;
+    }
+    EpdRefreshState& refreshes = context.epd_refreshes;
+    EpdUpdate batch = {0, 0, 0, 0, false, false};
+    EpdUpdate update;
+    while (xQueueReceive(context.epdQueue, &update, 0)) {
+        addEpdRequest(refreshes, batch, update);
+    }
+    results.epdBatches++;
+    if (results.epdQueued) {
+        results.epdQueueLatency.record(host::nowUs() - results.epdQueuedUs);
+        results.epdQueued = false;
+    }
+
+    EpdUpdate presented;
+    GFXcanvas1* frame = context.epd_frames.take(presented);
+    EpdRefresh refresh = planEpdRefresh(refreshes, batch, frame, presented);
+    if (frame) {
+        context.epd_frames.release();
+    }
+    if (refresh == EpdRefresh::NONE) {
+        return;
+    }
+    uint32_t elapsedMs = refresh == EpdRefresh::FULL ? EPD_FULL_MS : EPD_PARTIAL_MS;
+    context.epd_refresh.record(elapsedMs * 1000);
+    context.epd_active_ms += elapsedMs;
+}
+
+// An SNTP sync as the WiFi task does it: step the clock, then update the status.
+static void fakeSync(int32_t correctionUs) {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    int64_t us = (int64_t)tv.tv_sec * 1000000 + tv.tv_usec + correctionUs;
+    tv.tv_sec = us / 1000000;
+    tv.tv_usec = us % 1000000;
+    settimeofday(&tv, NULL);
+
+    struct tm local;
+    localtime_r(&tv.tv_sec, &local);
+    context.status_screen.set(STATUS_STATE, "Syncing...");
+    showStatus();
+    host::at(host::nowUs() + 120000, [] {
+        context.status_screen.set(STATUS_STATE, "Connected");
+        showStatus();
+    });
+    context.status_screen.set(STATUS_SYNC, "Last sync %02d:%02d", local.tm_hour, local.tm_min);
+    showStatus();
+}
+
+static LedMask litMask(const CRGB* leds) {
+    LedMask lit = 0;
+    for (uint8_t i = 0; i < NUM_LEDS; i++) {
+        if (leds[i]) {
+            lit |= 1ULL << i;
+        }
+    }
+    return lit;
+}
+
+// Compares the words on the LEDs with the local time the system clock gives.
+static void checkShownTime() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    time_t utc = tv.tv_sec;
+    struct tm local;
+    localtime_r(&utc, &local);
+    LedMask expected = goldenTimeMasks[local.tm_hour][local.tm_min / 5];
+    results.minuteChecks++;
+    if (litMask(context.leds) != expected) {
+        results.minuteMismatches++;
+        char buffer[32];
+        strftime(buffer, sizeof(buffer), "%H:%M:%S %Z", &local);
+        printf("Shown time differs at %s with scheme %d\n", buffer, context.colorSchemeIndex);
+    }
+}
+
+// --- Scenario ---
+
+static void scheduleScenario() {
+    // Boot: the RTC restores the time, the e-paper shows the connection
+    host::at(1200000, [] { sendCommand(SystemCommandType::START_CLOCK_DISPLAY); });
+    host::at(5 * SECOND_US, [] {
+        context.status_screen.set(STATUS_STATE, "Connected");
+        context.status_screen.set(STATUS_SSID, "SSID: simulation");
+        context.status_screen.set(STATUS_IP, "IP: 192.168.1.20");
+        showStatus();
+    });
+
+    // Hourly SNTP syncs, alternately correcting the clock forward and back
+    for (uint32_t hour = 0; hour < SIM_HOURS; hour++) {
+        int32_t correctionUs = hour % 2 ? -400000 : 300000;
+        host::at(hour * HOUR_US + 17 * SECOND_US, [correctionUs] { fakeSync(correctionUs); });
+    }
+
+    // The static scheme runs through the night, then every scheme for 2 hours
+    context.colorSchemeIndex = TIME_OF_DAY;
+    host::at(1 * HOUR_US, [] { results.staticWakeups = context.clock_wakeups; });
+    host::at(13 * HOUR_US, [] {
+        results.staticWakeups = context.clock_wakeups - results.staticWakeups;
+        results.staticMinutes = 12 * 60;
+    });
+    for (uint32_t hour = 14; hour < SIM_HOURS; hour += 2) {
+        host::at(hour * HOUR_US + 10 * SECOND_US, [] { sendCommand(SystemCommandType::NEXT_COLOR_SCHEME); });
+    }
+    host::at(20 * HOUR_US + 30 * SECOND_US, [] { sendCommand(SystemCommandType::EPD_FULL_REFRESH); });
+
+    every(EPD_SETTLE_MS * 1000, EPD_SETTLE_MS * 1000, fakeEpdTask);
+    every(MINUTE_US + 40 * SECOND_US, MINUTE_US, checkShownTime);
+}
+
+static void simulate() {
+    if (results.done) {
+        return;
+    }
+    setenv("TZ", SIM_TZ, 1);
+    tzset();
+    host::reset(SIM_START_UTC);
+    registerBuiltinColorSchemes();
+    context.systemCommandQueue = xQueueCreate(10, sizeof(SystemCommand));
+    context.epdQueue = xQueueCreate(4, sizeof(EpdUpdate));
+    context.bootEvents = xEventGroupCreate();
+    context.clockTask = xTaskGetCurrentTaskHandle();
+    TEST_ASSERT_TRUE(context.epd_frames.begin());
+    scheduleScenario();
+
+    host::runUntil(SIM_HOURS * HOUR_US);
+    uint64_t start = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now().time_since_epoch()).count();
+    try {
+        taskClockUpdate(&context);
+    } catch (const host::SimulationEnd&) {
+    }
+    results.hostNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now().time_since_epoch()).count() - start;
+    results.done = true;
+}
+
+void setUp() {
+    simulate();
+}
+
+void tearDown() {}
+
+// --- Tests ---
+
+static void test_shown_time_follows_local_time() {
+    // Includes the night CEST starts and a clock step every hour
+    TEST_ASSERT_EQUAL(SIM_HOURS * 60 - 1, results.minuteChecks);
+    TEST_ASSERT_EQUAL(0, results.minuteMismatches);
+}
+
+static void test_static_scheme_sleeps_between_minutes() {
+    // One wakeup per minute, full rate only for the crossfade every 5 minutes,
+    // and one more for the backward step of every other sync
+    uint32_t crossfades = results.staticMinutes / 5;
+    uint32_t crossfadeFrames = TRANSITION_DURATION_MS / FRAME_INTERVAL_MS;
+    TEST_ASSERT_GREATER_OR_EQUAL(results.staticMinutes + crossfades * (crossfadeFrames - 1), results.staticWakeups);
+    TEST_ASSERT_LESS_OR_EQUAL(results.staticMinutes + crossfades * crossfadeFrames + 6, results.staticWakeups);
+}
+
+static void test_minute_changes_are_shown_promptly() {
+    TEST_ASSERT_EQUAL(SIM_HOURS * 60 - 1, context.minute_latency.count);
+    // A forward step of the clock delays a sleeping static scheme by the step
+    TEST_ASSERT_LESS_THAN(400000, context.minute_latency.max_us);
+    TEST_ASSERT_LESS_THAN(1000, context.command_latency.max_us);
+}
+
+static void test_epd_requests_are_coalesced() {
+    // Every sync sends two updates at once and a third 120 ms later
+    TEST_ASSERT_EQUAL(1 + 3 * SIM_HOURS + 1, context.epd_refreshes.requests);
+    TEST_ASSERT_EQUAL(results.epdBatches, context.epd_refreshes.full + context.epd_refreshes.partial +
+                                              context.epd_refreshes.suppressed);
+    TEST_ASSERT_LESS_THAN(context.epd_refreshes.requests, results.epdBatches);
+    TEST_ASSERT_GREATER_OR_EQUAL(1, context.epd_refreshes.full);
+}
+
+static void test_print_report() {
+    printf("Simulated %u h in %llu ms, %llu ns/frame on the host\n", SIM_HOURS,
+           (unsigned long long)(results.hostNs / 1000000),
+           (unsigned long long)(results.hostNs / (context.frames_rendered ? context.frames_rendered : 1)));
+    printTimingStatsHeader(Serial);
+    printTimingStats("command_latency", context.command_latency, Serial);
+    printTimingStats("frame_render", context.frame_render, Serial);
+    printTimingStats("frame_interval", context.frame_interval, Serial);
+    printTimingStats("epd_refresh", context.epd_refresh, Serial);
+    printTimingStats("epd_queue_latency", results.epdQueueLatency, Serial);
+    printTimingStats("minute_latency", context.minute_latency, Serial);
+    Serial.println("counter,value");
+    Serial.printf("clock_wakeups,%u\n", context.clock_wakeups);
+    Serial.printf("frames_rendered,%u\n", context.frames_rendered);
+    Serial.printf("frames_pushed,%u\n", context.frames_pushed);
+    Serial.printf("static_scheme_wakeups_per_minute,%.2f\n",
+                  (double)results.staticWakeups / results.staticMinutes);
+    Serial.printf("epd_refresh_requests,%u\n", context.epd_refreshes.requests);
+    Serial.printf("epd_full_refreshes,%u\n", context.epd_refreshes.full);
+    Serial.printf("epd_partial_refreshes,%u\n", context.epd_refreshes.partial);
+    Serial.printf("epd_suppressed_refreshes,%u\n", context.epd_refreshes.suppressed);
+    Serial.printf("epd_active_ms_per_day,%u\n", (uint32_t)((uint64_t)context.epd_active_ms * 24 / SIM_HOURS));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_shown_time_follows_local_time);
+    RUN_TEST(test_static_scheme_sleeps_between_minutes);
+    RUN_TEST(test_minute_changes_are_shown_promptly);
+    RUN_TEST(test_epd_requests_are_coalesced);
+    RUN_TEST(test_print_report);
+    return UNITY_END();
+}
@@ -0,0 +1,189 @@
+/**
+ * @file test_main.cpp
+ * @brief Host tests and benchmarks for the LED renderer: pio test -e native -f test_render -v
+ *
+ * Frames are rendered into memory through writeTime() with every registered
+ * color scheme. The settled frames are checked against goldenTimeMasks, the
+ * benchmark prints ns/frame and heap allocations/frame as CSV, and the frame
+ * dump prints an ASCII grid per scheme. Set FRAME_DUMP_DIR to also write a
+ * PPM image per scheme into that directory.
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <new>
+#include <Arduino.h>
+#include "color_schemes.h"
+#include "frame_debug.h"
+#include "time_display.h"
+#include "time_golden.h"
+#include "animations.h"
+#include "palettes.h"
+
+// --- Allocation counting ---
+// Everything allocated through new on the host; the renderer should need none.
+
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* p = malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+#define BENCH_FRAMES 20000
+
+static uint64_t nowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static LedMask litMask(const CRGB* leds) {
+    LedMask lit = 0;
+    for (uint8_t i = 0; i < NUM_LEDS; i++) {
+        if (leds[i]) {
+            lit |= 1ULL << i;
+        }
+    }
+    return lit;
+}
+
+// Draws a sentence and lets its crossfade settle. The settled frame always
+// starts from the same random seed, so randomized schemes can be compared.
+static void renderSettled(int hours, int minutes, CRGB* leds, uint8_t scheme, MaskTransition& transition,
+                          uint32_t now) {
+    CHSV color((hours * 60 + minutes) % 256, 255, 255);
+    writeTime(hours, minutes, leds, color, scheme, transition, now);
+    random16_set_seed(1337);
+    writeTime(hours, minutes, leds, color, scheme, transition, now + transition.durationMs);
+}
+
+void setUp() {
+    if (colorSchemeCount() == 0) {
+        registerBuiltinColorSchemes();
+    }
+}
+
+void tearDown() {}
+
+// --- Tests ---
+
+static void test_settled_frames_match_golden_masks() {
+    CRGB leds[NUM_LEDS];
+    for (uint8_t scheme = 0; scheme < colorSchemeCount(); scheme++) {
+        MaskTransition transition;
+        for (uint16_t minuteOfDay = 0; minuteOfDay < 24 * 60; minuteOfDay++) {
+            int hours = minuteOfDay / 60;
+            int minutes = minuteOfDay % 60;
+            renderSettled(hours, minutes, leds, scheme, transition, (uint32_t)minuteOfDay * 60000);
+            char message[64];
+            snprintf(message, sizeof(message), "%s at %02d:%02d", colorScheme(scheme).name, hours, minutes);
+            TEST_ASSERT_EQUAL_UINT64_MESSAGE(goldenTimeMasks[hours][minutes / 5], litMask(leds), message);
+        }
+    }
+}
+
+static void test_settled_frame_matches_fresh_render() {
+    // A settled crossfade must look exactly like a frame drawn without one
+    for (uint8_t scheme = 0; scheme < colorSchemeCount(); scheme++) {
+        CRGB settled[NUM_LEDS];
+        CRGB fresh[NUM_LEDS];
+        MaskTransition transition;
+        MaskTransition freshTransition;
+        renderSettled(10, 5, settled, scheme, transition, 600000);
+        renderSettled(10, 10, settled, scheme, transition, 660000);
+        renderSettled(10, 10, fresh, scheme, freshTransition, 660000);
+        TEST_ASSERT_TRUE_MESSAGE(memcmp(settled, fresh, sizeof(fresh)) == 0, colorScheme(scheme).name);
+    }
+}
+
+static void test_rainbow_lut_matches_fastled_expansion() {
+    // The compile-time table must match what FastLED expands at run time
+    CRGBPalette256 expanded = RainbowColors_p;
+    for (int i = 0; i < 256; i++) {
+        TEST_ASSERT_EQUAL_UINT8(expanded[i].r, rainbowLut[i].r);
+        TEST_ASSERT_EQUAL_UINT8(expanded[i].g, rainbowLut[i].g);
+        TEST_ASSERT_EQUAL_UINT8(expanded[i].b, rainbowLut[i].b);
+    }
+}
+
+static void test_benchmark_color_schemes() {
+    CRGB leds[NUM_LEDS];
+    printf("scheme,name,frames,ns_per_frame,allocs_per_frame\n");
+    for (uint8_t scheme = 0; scheme < colorSchemeCount(); scheme++) {
+        MaskTransition transition;
+        size_t allocationsBefore = allocations;
+        uint64_t start = nowNs();
+        for (uint32_t f = 0; f < BENCH_FRAMES; f++) {
+            // Full-rate frames over 400 s, so the benchmark includes several sentence crossfades
+            uint32_t now = f * FRAME_INTERVAL_MS;
+            uint32_t minuteOfDay = 10 * 60 + now / 60000;
+            writeTime(minuteOfDay / 60, minuteOfDay % 60, leds, CHSV(now / 60, 255, 255), scheme, transition, now);
+        }
+        uint64_t elapsed = nowNs() - start;
+        size_t frameAllocations = allocations - allocationsBefore;
+        printf("%u,%s,%u,%llu,%.3f\n", scheme, colorScheme(scheme).name, BENCH_FRAMES,
+               (unsigned long long)(elapsed / BENCH_FRAMES), (double)frameAllocations / BENCH_FRAMES);
+        TEST_ASSERT_EQUAL_MESSAGE(0, frameAllocations, colorScheme(scheme).name);
+    }
+}
+
+static void test_benchmark_wifi_animation() {
+    CRGB leds[NUM_LEDS] = {};
+    AnimationStack animations;
+    animations.start(wifiConnectAnimation(0));
+    size_t allocationsBefore = allocations;
+    uint32_t frames = 0;
+    uint64_t start = nowNs();
+    for (uint32_t now = 0; animations.tick(leds, now); now += FRAME_INTERVAL_MS) {
+        frames++;
+    }
+    uint64_t elapsed = nowNs() - start;
+    size_t frameAllocations = allocations - allocationsBefore;
+    printf("animation,name,frames,ns_per_frame,allocs_per_frame\n");
+    printf("0,WiFi connect,%u,%llu,%.3f\n", frames, (unsigned long long)(elapsed / frames),
+           (double)frameAllocations / frames);
+    TEST_ASSERT_EQUAL(8000 / FRAME_INTERVAL_MS + 1, frames);
+    TEST_ASSERT_EQUAL(0, frameAllocations);
+}
+
+static void test_dump_frames() {
+    const char* dumpDir = getenv("FRAME_DUMP_DIR");
+    for (uint8_t scheme = 0; scheme < colorSchemeCount(); scheme++) {
+        CRGB leds[NUM_LEDS];
+        MaskTransition transition;
+        // "It is twenty five minutes past ten"
+        renderSettled(10, 25, leds, scheme, transition, 600000);
+        printf("--- %u: %s, 10:25 ---\n", scheme, colorScheme(scheme).name);
+        printFrameAscii(leds, Serial);
+
+        if (dumpDir) {
+            char path[256];
+            snprintf(path, sizeof(path), "%s/scheme%u.ppm", dumpDir, scheme);
+            FILE* file = fopen(path, "w");
+            TEST_ASSERT_TRUE_MESSAGE(file != nullptr, path);
+            FilePrint out(file);
+            printFramePpm(leds, out);
+            fclose(file);
+        }
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_settled_frames_match_golden_masks);
+    RUN_TEST(test_settled_frame_matches_fresh_render);
+    RUN_TEST(test_rainbow_lut_matches_fastled_expansion);
+    RUN_TEST(test_benchmark_color_schemes);
+    RUN_TEST(test_benchmark_wifi_animation);
+    RUN_TEST(test_dump_frames);
+    return UNITY_END();
+}
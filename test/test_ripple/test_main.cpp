@@ -0,0 +1,97 @@
+/**
+ * @file test_main.cpp
+ * @brief Host benchmark of the rainbow ripple: pio test -e native -f test_ripple -v
+ *
+ * Compares the original per-word ripple, which computed every letter's
+ * distance with sqrt/pow in floating point, with the table-driven
+ * rainbowRipple() that reads ledGeometry and the rainbow palette LUT.
+ * The radius table must match the float distances exactly; the timings
+ * are only printed, as wall-clock time varies with the host's load.
+ */
+
+#include <unity.h>
+#include <chrono>
+#include <Arduino.h>
+#include "color_schemes.h"
+#include "led_geometry.h"
+#include "time_golden.h"
+
+#define BENCH_FRAMES 20000
+
+// The ripple as it was before the geometry tables, kept for comparison.
+static void floatRainbowRipple(const Word& w, CRGB* ledArray, CHSV color) {
+    uint8_t base = color.hue;
+    for (int i = 0; i < w.wordLength; i++) {
+        float letterX = w.x + i;
+        float letterY = (float)w.y * 1.6;
+        float distance = sqrt(pow(letterX, 2) + pow(letterY, 2));
+        long dist = (long)(distance * 8);
+        dist = dist % 256;
+        color.hue = base - (uint8_t)dist;
+        ledArray[w.startIndex + i] = color;
+    }
+}
+
+static void floatRainbowRipple(LedMask mask, CRGB* ledArray, CHSV color) {
+    for (const Word& w : clockWords) {
+        if ((mask & wordMask(w)) == wordMask(w)) {
+            floatRainbowRipple(w, ledArray, color);
+        }
+    }
+}
+
+static uint64_t nowNs() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static LedMask benchMask(uint32_t frame) {
+    return goldenTimeMasks[(frame / 12) % 24][frame % 12];
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+// --- Tests ---
+
+static void test_radius_matches_float_distance() {
+    // The Q5.3 radius table must agree with the float distance the old ripple used
+    for (const Word& w : clockWords) {
+        for (uint8_t i = 0; i < w.wordLength; i++) {
+            float letterY = (float)w.y * 1.6;
+            long dist = (long)(sqrt(pow(w.x + i, 2) + pow(letterY, 2)) * 8) % 256;
+            TEST_ASSERT_EQUAL_MESSAGE(dist, ledGeometry[w.startIndex + i].radius, w.name);
+        }
+    }
+}
+
+static void test_benchmark_ripple_paths() {
+    CRGB leds[NUM_LEDS] = {};
+    volatile uint8_t sink = 0; // Keeps the frames from being optimized away
+
+    uint64_t start = nowNs();
+    for (uint32_t f = 0; f < BENCH_FRAMES; f++) {
+        floatRainbowRipple(benchMask(f), leds, CHSV(f, 255, 255));
+        sink = sink + leds[f % NUM_LEDS].r;
+    }
+    uint64_t floatNs = (nowNs() - start) / BENCH_FRAMES;
+
+    start = nowNs();
+    for (uint32_t f = 0; f < BENCH_FRAMES; f++) {
+        rainbowRipple(benchMask(f), leds, CHSV(f, 255, 255));
+        sink = sink + leds[f % NUM_LEDS].r;
+    }
+    uint64_t tableNs = (nowNs() - start) / BENCH_FRAMES;
+
+    printf("path,frames,ns_per_frame\n");
+    printf("float sqrt/pow per word,%u,%llu\n", BENCH_FRAMES, (unsigned long long)floatNs);
+    printf("ledGeometry + palette LUT,%u,%llu\n", BENCH_FRAMES, (unsigned long long)tableNs);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_radius_matches_float_distance);
+    RUN_TEST(test_benchmark_ripple_paths);
+    return UNITY_END();
+}
@@ -0,0 +1,114 @@
+/**
+ * @file test_main.cpp
+ * @brief Tests for the DS3231 drift arithmetic: pio test -e native -f test_rtc_drift -v
+ */
+
+#include <unity.h>
+#include "rtc_drift.h"
+
+void setUp() {}
+
+void tearDown() {}
+
+// --- measuredPpm ---
+
+static void test_measured_ppm() {
+    // 1 ppm is 1 ms per 1000 s
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f, measuredPpm(1, 1000));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 2.0f, measuredPpm(864, 432000));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, -2.0f, measuredPpm(-864, 432000));
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, measuredPpm(500, 0));
+}
+
+// --- addDriftSample ---
+
+static void test_first_samples_are_a_running_mean() {
+    DriftEstimate estimate = {0.0f, 0};
+    addDriftSample(estimate, 3.0f, 0);
+    TEST_ASSERT_EQUAL_UINT8(1, estimate.samples);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 3.0f, estimate.crystalPpm);
+    addDriftSample(estimate, 1.0f, 0);
+    TEST_ASSERT_EQUAL_UINT8(2, estimate.samples);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 2.0f, estimate.crystalPpm);
+}
+
+static void test_sample_adds_back_the_aging_offset() {
+    // A residual of 0.5 ppm measured with an offset of +20 LSB: the crystal itself is 2.5 ppm fast
+    DriftEstimate estimate = {0.0f, 0};
+    addDriftSample(estimate, 0.5f, 20);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 2.5f, estimate.crystalPpm);
+}
+
+static void test_estimate_converges_with_the_offset_in_the_loop() {
+    // Simulate daily syncs of a crystal 3.3 ppm fast, programming each new offset
+    const float crystalPpm = 3.3f;
+    DriftEstimate estimate = {0.0f, 0};
+    int8_t aging = 0;
+    for (int day = 0; day < 20; day++) {
+        float residual = crystalPpm - aging * AGING_PPM_PER_LSB;
+        addDriftSample(estimate, residual, aging);
+        aging = agingOffsetFor(estimate);
+    }
+    TEST_ASSERT_EQUAL_UINT8(DRIFT_AVERAGE_SAMPLES, estimate.samples);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, crystalPpm, estimate.crystalPpm);
+    TEST_ASSERT_EQUAL_INT8(33, aging);
+}
+
+static void test_estimate_follows_a_change_exponentially() {
+    DriftEstimate estimate = {1.0f, DRIFT_AVERAGE_SAMPLES};
+    addDriftSample(estimate, 5.0f, 0);
+    TEST_ASSERT_EQUAL_UINT8(DRIFT_AVERAGE_SAMPLES, estimate.samples);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.0f + 4.0f / DRIFT_AVERAGE_SAMPLES, estimate.crystalPpm);
+}
+
+// --- agingOffsetFor ---
+
+static void test_aging_offset_rounds_to_nearest() {
+    TEST_ASSERT_EQUAL_INT8(0, agingOffsetFor({0.04f, 1}));
+    TEST_ASSERT_EQUAL_INT8(1, agingOffsetFor({0.06f, 1}));
+    TEST_ASSERT_EQUAL_INT8(-1, agingOffsetFor({-0.06f, 1}));
+    TEST_ASSERT_EQUAL_INT8(25, agingOffsetFor({2.5f, 1}));
+    TEST_ASSERT_EQUAL_INT8(-25, agingOffsetFor({-2.5f, 1}));
+}
+
+static void test_aging_offset_clamps_to_register_range() {
+    TEST_ASSERT_EQUAL_INT8(127, agingOffsetFor({12.7f, 1}));
+    TEST_ASSERT_EQUAL_INT8(127, agingOffsetFor({50.0f, 1}));
+    TEST_ASSERT_EQUAL_INT8(-128, agingOffsetFor({-12.8f, 1}));
+    TEST_ASSERT_EQUAL_INT8(-128, agingOffsetFor({-50.0f, 1}));
+}
+
+// --- nextSyncInterval ---
+
+static void test_interval_at_most_doubles() {
+    // No measurable drift would allow the maximum, but one sync may only double it
+    TEST_ASSERT_EQUAL_UINT32(7200, nextSyncInterval(3600, 0.0f, 250, 3600, 86400));
+    TEST_ASSERT_EQUAL_UINT32(14400, nextSyncInterval(7200, 0.01f, 250, 3600, 86400));
+}
+
+static void test_interval_is_time_to_reach_target() {
+    // 250 ms at 5 ppm takes 50000 s; the sign of the drift does not matter
+    TEST_ASSERT_EQUAL_UINT32(50000, nextSyncInterval(43200, 5.0f, 250, 3600, 86400));
+    TEST_ASSERT_EQUAL_UINT32(50000, nextSyncInterval(43200, -5.0f, 250, 3600, 86400));
+}
+
+static void test_interval_is_clamped() {
+    TEST_ASSERT_EQUAL_UINT32(3600, nextSyncInterval(7200, 200.0f, 250, 3600, 86400));
+    TEST_ASSERT_EQUAL_UINT32(86400, nextSyncInterval(86400, 0.0f, 250, 3600, 86400));
+    TEST_ASSERT_EQUAL_UINT32(86400, nextSyncInterval(60000, 1.0f, 250, 3600, 86400));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_measured_ppm);
+    RUN_TEST(test_first_samples_are_a_running_mean);
+    RUN_TEST(test_sample_adds_back_the_aging_offset);
+    RUN_TEST(test_estimate_converges_with_the_offset_in_the_loop);
+    RUN_TEST(test_estimate_follows_a_change_exponentially);
+    RUN_TEST(test_aging_offset_rounds_to_nearest);
+    RUN_TEST(test_aging_offset_clamps_to_register_range);
+    RUN_TEST(test_interval_at_most_doubles);
+    RUN_TEST(test_interval_is_time_to_reach_target);
+    RUN_TEST(test_interval_is_clamped);
+    return UNITY_END();
+}